@@ -0,0 +1,171 @@
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include "ast.hpp"
+#include "code_generator.hpp"
+#include "frontend.hpp"
+#include "global_context.hpp"
+#include "lexer.hpp"
+#include "parser.hpp"
+#include "semantic_analyzer.hpp"
+#include "synthetic.hpp"
+
+// Throughput of every stage of the frontend on synthetic sources.
+// Lexer reports bytes/s, parser and semantic analyzer report AST nodes/s, code generator reports IR instructions/s.
+
+namespace {
+
+    const auto operators = operator_precedence{frontend::default_operators()};
+
+    auto make_lexer(const std::string& text) -> lexer {
+	return lexer{source_buffer{llvm::MemoryBuffer::getMemBuffer(text, "bench")}};
+    }
+
+    /**
+     * Parse whole module, aborts benchmark if generated source is invalid
+     */
+    auto parse(benchmark::State& state, const std::string& text, ast::arena& arena) -> ast::function_list {
+	auto p = parser{make_lexer(text), operators, arena};
+	auto functions = p.parse_module();
+	if(!functions) {
+	    state.SkipWithError("unable to parse synthetic source");
+	    return arena.make_list<ast::function_expression*>();
+	}
+	return std::move(*functions);
+    }
+
+    /**
+     * Run semantic analysis of parsed module
+     * @return false if any function failed
+     */
+    auto analyse(ast::function_list& functions, ast::arena& arena) -> bool {
+	auto sa = semantic_analyzer{arena};
+	for(const auto& function: functions)
+	    sa.declare_function(function->name(), global_context::type(function->types(), function->return_type()));
+	bool succeeded = true;
+	for(const auto& function: functions)
+	    succeeded = function->accept(&sa) && succeeded;
+	return succeeded;
+    }
+
+    auto lex(benchmark::State& state, const std::string& text) -> void {
+	for(auto _: state) {
+	    auto l = make_lexer(text);
+	    while(l.token() != tokens::eof)
+		l.consume();
+	    benchmark::DoNotOptimize(l.token_count());
+	}
+	state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * text.size()));
+    }
+
+    auto lexer_expressions(benchmark::State& state) -> void {
+	lex(state, synthetic::deep_expressions(static_cast<std::size_t>(state.range(0)), 64));
+    }
+
+    auto lexer_integer_literals(benchmark::State& state) -> void {
+	lex(state, synthetic::integer_literals(static_cast<std::size_t>(state.range(0)), 38));
+    }
+
+    auto lexer_comments(benchmark::State& state) -> void {
+	lex(state, synthetic::comments(1024, static_cast<std::size_t>(state.range(0))));
+    }
+
+    auto lexer_strings(benchmark::State& state) -> void {
+	lex(state, synthetic::strings(1024, static_cast<std::size_t>(state.range(0))));
+    }
+
+    auto parser_expression_chain(benchmark::State& state) -> void {
+	auto text = synthetic::expression_chain(static_cast<std::size_t>(state.range(0)));
+	std::size_t nodes = 0;
+	for(auto _: state) {
+	    auto arena = ast::arena{};
+	    auto p = parser{make_lexer(text), operators, arena};
+	    benchmark::DoNotOptimize(p.parse_expression());
+	    nodes += arena.node_count();
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(nodes));
+    }
+
+    auto parser_wide_calls(benchmark::State& state) -> void {
+	auto text = synthetic::wide_calls(256, static_cast<std::size_t>(state.range(0)));
+	std::size_t nodes = 0;
+	for(auto _: state) {
+	    auto arena = ast::arena{};
+	    benchmark::DoNotOptimize(parse(state, text, arena));
+	    nodes += arena.node_count();
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(nodes));
+    }
+
+    /**
+     * Analysis inserts implicit casts into AST, so every iteration analyses freshly parsed module
+     */
+    auto sema(benchmark::State& state, const std::string& text) -> void {
+	std::size_t nodes = 0;
+	for(auto _: state) {
+	    state.PauseTiming();
+	    auto arena = ast::arena{};
+	    auto functions = parse(state, text, arena);
+	    nodes += arena.node_count();
+	    state.ResumeTiming();
+
+	    if(!analyse(functions, arena))
+		state.SkipWithError("unable to analyse synthetic source");
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(nodes));
+    }
+
+    auto sema_expressions(benchmark::State& state) -> void {
+	sema(state, synthetic::deep_expressions(64, static_cast<std::size_t>(state.range(0))));
+    }
+
+    auto sema_wide_calls(benchmark::State& state) -> void {
+	sema(state, synthetic::wide_calls(64, static_cast<std::size_t>(state.range(0))));
+    }
+
+    auto codegen(benchmark::State& state, const std::string& text) -> void {
+	std::size_t instructions = 0;
+	for(auto _: state) {
+	    state.PauseTiming();
+	    auto arena = ast::arena{};
+	    auto functions = parse(state, text, arena);
+	    if(!analyse(functions, arena))
+		state.SkipWithError("unable to analyse synthetic source");
+	    state.ResumeTiming();
+
+	    auto cg = code_generator{"bench"};
+	    for(const auto& function: functions)
+		cg.declare_function(function->name(), static_cast<types::function_type*>(function->type()));
+	    for(const auto& function: functions)
+		benchmark::DoNotOptimize(function->accept(&cg));
+	    instructions += cg.get_module().getInstructionCount();
+	}
+	state.SetItemsProcessed(static_cast<int64_t>(instructions));
+    }
+
+    auto codegen_expressions(benchmark::State& state) -> void {
+	codegen(state, synthetic::deep_expressions(64, static_cast<std::size_t>(state.range(0))));
+    }
+
+    auto codegen_wide_calls(benchmark::State& state) -> void {
+	codegen(state, synthetic::wide_calls(64, static_cast<std::size_t>(state.range(0))));
+    }
+
+}
+
+BENCHMARK(lexer_expressions)->RangeMultiplier(8)->Range(8, 1 << 12);
+BENCHMARK(lexer_integer_literals)->RangeMultiplier(8)->Range(8, 1 << 15);
+BENCHMARK(lexer_comments)->RangeMultiplier(8)->Range(8, 1 << 12);
+BENCHMARK(lexer_strings)->RangeMultiplier(8)->Range(8, 1 << 12);
+BENCHMARK(parser_expression_chain)->RangeMultiplier(8)->Range(8, 1 << 15);
+BENCHMARK(parser_wide_calls)->RangeMultiplier(4)->Range(4, 1 << 10);
+BENCHMARK(sema_expressions)->RangeMultiplier(8)->Range(8, 1 << 12);
+BENCHMARK(sema_wide_calls)->RangeMultiplier(4)->Range(4, 1 << 10);
+BENCHMARK(codegen_expressions)->RangeMultiplier(8)->Range(8, 1 << 12);
+BENCHMARK(codegen_wide_calls)->RangeMultiplier(4)->Range(4, 1 << 10);
+
+BENCHMARK_MAIN();
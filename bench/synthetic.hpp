@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <random>
+#include <string>
+
+// Generators of synthetic sources for benchmarks.
+// Every generator is seeded with a constant, so that the same arguments always produce the same text.
+
+namespace synthetic {
+
+    inline constexpr const char* operators[] = {"+", "-", "*", "/"};
+
+    /**
+     * Expression of length operands joined by random binary operators e.g. "x + y * x - y"
+     */
+    inline auto expression_chain(std::size_t length) -> std::string {
+	std::mt19937 random{1};
+	std::string text = "x";
+	for(std::size_t i = 1; i < length; ++i) {
+	    text += ' ';
+	    text += operators[random() % 4];
+	    text += i % 2 ? " y" : " x";
+	}
+	return text;
+    }
+
+    /**
+     * Module of count functions, every one returns an expression chain of given length
+     */
+    inline auto deep_expressions(std::size_t count, std::size_t length) -> std::string {
+	std::string text;
+	auto body = expression_chain(length);
+	for(std::size_t i = 0; i < count; ++i)
+	    text += "function f" + std::to_string(i) + "(x int64, y int64) int64\n    " + body + "\n\n";
+	return text;
+    }
+
+    /**
+     * Module with one function of width parameters and count functions that call it
+     */
+    inline auto wide_calls(std::size_t count, std::size_t width) -> std::string {
+	std::string text = "function callee(";
+	for(std::size_t i = 0; i < width; ++i)
+	    text += (i ? ", a" : "a") + std::to_string(i) + " int64";
+	text += ") int64\n    a0\n\n";
+
+	std::string call = "callee(";
+	for(std::size_t i = 0; i < width; ++i)
+	    call += i ? (i % 2 ? ", y" : ", x") : "x";
+	call += ')';
+
+	for(std::size_t i = 0; i < count; ++i)
+	    text += "function f" + std::to_string(i) + "(x int64, y int64) int64\n    " + call + "\n\n";
+	return text;
+    }
+
+    /**
+     * Sum of count integer literals with up to digits digits in mixed radixes
+     */
+    inline auto integer_literals(std::size_t count, std::size_t digits) -> std::string {
+	std::mt19937 random{2};
+	std::string text;
+	for(std::size_t i = 0; i < count; ++i) {
+	    std::size_t length = 1 + random() % digits;
+	    switch(random() % 4) {
+		case 0:
+		    text += "0b";
+		    for(std::size_t d = 0; d < length; ++d)
+			text += static_cast<char>('0' + random() % 2);
+		    break;
+		case 1:
+		    text += "0x";
+		    for(std::size_t d = 0; d < length; ++d)
+			text += "0123456789abcdef"[random() % 16];
+		    break;
+		default:
+		    text += static_cast<char>('1' + random() % 9);
+		    for(std::size_t d = 1; d < length; ++d)
+			text += static_cast<char>('0' + random() % 10);
+	    }
+	    text += i + 1 != count ? " + " : "\n";
+	}
+	return text;
+    }
+
+    /**
+     * Lines of count comments, every one width characters long, alternating between // and /* ... * /
+     */
+    inline auto comments(std::size_t count, std::size_t width) -> std::string {
+	std::string text;
+	std::string filler(width, 'c');
+	for(std::size_t i = 0; i < count; ++i)
+	    text += i % 2 ? "/* " + filler + " */\n" : "// " + filler + '\n';
+	return text;
+    }
+
+    /**
+     * Lines of count string literals, every one width characters long
+     */
+    inline auto strings(std::size_t count, std::size_t width) -> std::string {
+	std::string text;
+	std::string filler(width, 's');
+	for(std::size_t i = 0; i < count; ++i)
+	    text += '"' + filler + "\"\n";
+	return text;
+    }
+
+}
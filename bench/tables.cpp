@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "flat_hash_map.hpp"
+#include "interner.hpp"
+
+// Compare lookups in std::map, which used to back table_base, with flat_hash_map.
+// Keys have the shapes used by tables.hpp: symbols, pairs of symbol and pointer, strings.
+
+namespace {
+
+    struct dummy_type { int _unused; };
+
+    /**
+     * Keys looked up in shuffled order, so that neither container benefits from sequential access
+     */
+    template<typename Key>
+    auto shuffled(std::vector<Key> keys) -> std::vector<Key> {
+	std::shuffle(keys.begin(), keys.end(), std::mt19937{42});
+	return keys;
+    }
+
+    auto symbol_keys(std::size_t count) -> std::vector<symbol> {
+	std::vector<symbol> keys;
+	for(std::size_t i = 0; i < count; ++i)
+	    keys.push_back(static_cast<symbol>(i * 7 + 1));
+	return keys;
+    }
+
+    auto operation_keys(std::size_t count, std::vector<std::unique_ptr<dummy_type>>& types) -> std::vector<std::pair<symbol, dummy_type*>> {
+	for(std::size_t i = 0; i < 16; ++i)
+	    types.push_back(std::make_unique<dummy_type>());
+
+	std::vector<std::pair<symbol, dummy_type*>> keys;
+	for(std::size_t i = 0; i < count; ++i)
+	    keys.emplace_back(static_cast<symbol>(i / types.size() + 1), types[i % types.size()].get());
+	return keys;
+    }
+
+    auto string_keys(std::size_t count) -> std::vector<std::string> {
+	std::vector<std::string> keys;
+	for(std::size_t i = 0; i < count; ++i)
+	    keys.push_back("identifier_" + std::to_string(i));
+	return keys;
+    }
+
+    template<typename Map, typename Key>
+    auto lookup(benchmark::State& state, const std::vector<Key>& keys) -> void {
+	Map map;
+	for(std::size_t i = 0; i < keys.size(); ++i)
+	    map[keys[i]] = i;
+
+	auto order = shuffled(keys);
+	for(auto _: state)
+	    for(const auto& key: order)
+		benchmark::DoNotOptimize(map.find(key));
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * order.size()));
+    }
+
+    template<template<typename, typename> typename Map>
+    auto symbol_lookup(benchmark::State& state) -> void {
+	lookup<Map<symbol, std::size_t>>(state, symbol_keys(static_cast<std::size_t>(state.range(0))));
+    }
+
+    template<template<typename, typename> typename Map>
+    auto operation_lookup(benchmark::State& state) -> void {
+	std::vector<std::unique_ptr<dummy_type>> types;
+	lookup<Map<std::pair<symbol, dummy_type*>, std::size_t>>(state, operation_keys(static_cast<std::size_t>(state.range(0)), types));
+    }
+
+    template<template<typename, typename> typename Map>
+    auto string_view_lookup(benchmark::State& state) -> void {
+	auto keys = string_keys(static_cast<std::size_t>(state.range(0)));
+	Map<std::string, std::size_t> map;
+	for(std::size_t i = 0; i < keys.size(); ++i)
+	    map[keys[i]] = i;
+
+	std::vector<std::string_view> order(keys.begin(), keys.end());
+	order = shuffled(std::move(order));
+	for(auto _: state)
+	    for(auto key: order)
+		benchmark::DoNotOptimize(map.find(key));
+	state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * order.size()));
+    }
+
+    template<typename K, typename V>
+    using tree_map = std::map<K, V, std::less<>>;
+
+    template<typename K, typename V>
+    using flat_map = flat_hash_map<K, V>;
+
+}
+
+BENCHMARK(symbol_lookup<tree_map>)->RangeMultiplier(8)->Range(8, 1 << 15);
+BENCHMARK(symbol_lookup<flat_map>)->RangeMultiplier(8)->Range(8, 1 << 15);
+BENCHMARK(operation_lookup<tree_map>)->RangeMultiplier(8)->Range(8, 1 << 15);
+BENCHMARK(operation_lookup<flat_map>)->RangeMultiplier(8)->Range(8, 1 << 15);
+BENCHMARK(string_view_lookup<tree_map>)->RangeMultiplier(8)->Range(8, 1 << 15);
+BENCHMARK(string_view_lookup<flat_map>)->RangeMultiplier(8)->Range(8, 1 << 15);
+
+BENCHMARK_MAIN();
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ast/expression.hpp"
+#include "ast/arena.hpp"
 #include "ast/integer_literal.hpp"
 #include "ast/floating_literal.hpp"
 #include "ast/character_literal.hpp"
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+#include "expression.hpp"
+
+namespace ast {
+
+    /**
+     * Owner of all AST nodes of one compilation unit.
+     * Nodes and their child lists are bump-allocated next to each other
+     * and released together when arena is destroyed.
+     * Node destructors are never run, so nodes must not own memory outside of arena
+     */
+    class arena {
+    private:
+	std::pmr::monotonic_buffer_resource _resource; ///< bump allocator that backs all nodes
+	std::size_t _nodes{};                          ///< number of nodes created
+	std::size_t _bytes{};                          ///< size of nodes created
+
+    public:
+	/**
+	 * Constructor of arena
+	 * @param initial_size a size of the first block to allocate nodes from
+	 */
+	arena(std::size_t initial_size = 64 * 1024);
+
+	arena(const arena&)           = delete;
+	arena(arena&&)                = delete;
+	auto operator=(const arena&)  = delete;
+	auto operator=(arena&&)       = delete;
+	~arena()                      = default;
+
+	/**
+	 * Create new node inside of arena
+	 * @tparam T a type of node to create
+	 * @param args arguments that are forwarded to the constructor of node
+	 * @return pointer to the node, valid as long as arena is alive
+	 */
+	template<std::derived_from<expression> T, typename... Args>
+	[[nodiscard]] auto make(Args&&... args) -> T* {
+	    ++_nodes;
+	    _bytes += sizeof(T);
+	    return std::pmr::polymorphic_allocator<>{&_resource}.new_object<T>(std::forward<Args>(args)...);
+	}
+
+	/**
+	 * Create empty list which elements are allocated inside of arena
+	 * @tparam T a type of list elements
+	 */
+	template<typename T>
+	[[nodiscard]] auto make_list() -> std::pmr::vector<T> {
+	    return std::pmr::vector<T>{&_resource};
+	}
+
+	/**
+	 * Get memory resource of arena
+	 */
+	[[nodiscard]] auto resource() noexcept -> std::pmr::memory_resource*;
+
+	/**
+	 * Get number of nodes created in arena
+	 */
+	[[nodiscard]] auto node_count() const noexcept -> std::size_t;
+
+	/**
+	 * Get total size of nodes created in arena, child lists are not included
+	 */
+	[[nodiscard]] auto node_bytes() const noexcept -> std::size_t;
+    };
+
+}
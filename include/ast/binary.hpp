@@ -1,9 +1,8 @@
 #pragma once
 
-#include <string>
-
 #include "expression.hpp"
 #include "implicit_cast.hpp"
+#include "interner.hpp"
 
 namespace ast {
 
@@ -14,8 +13,8 @@ namespace ast {
      */
     class binary_expression : public expression {
     private:
-	std::string _operator; ///< Operator between 2 expressions
-	std::unique_ptr<expression> _lhs, _rhs; ///< Expression of binary expression
+	symbol _operator; ///< Operator between 2 expressions
+	expression* _lhs, * _rhs; ///< Expression of binary expression
 
     public:
 	/**
@@ -24,7 +23,7 @@ namespace ast {
 	 * @param lhs an left hand side expression node
 	 * @param rhs a right hand side expression node
 	 */
-	binary_expression(std::string&& op, std::unique_ptr<expression>&& lhs, std::unique_ptr<expression>&& rhs);
+	binary_expression(symbol op, expression* lhs, expression* rhs);
 
 	[[nodiscard]] virtual auto accept(value_visitor*) const -> llvm::Value* override;
 	[[nodiscard]] virtual auto accept(type_visitor*) -> types::type* override;
@@ -32,7 +31,7 @@ namespace ast {
 	/**
 	 * Accessor of operator for binary_expression
 	 */
-	[[nodiscard]] auto op()  const -> const std::string&;
+	[[nodiscard]] auto op()  const -> symbol;
 
 	/**
 	 * Accessor of lhs expression for const binary_expression
@@ -60,7 +59,7 @@ namespace ast {
 	 * @param builder an instance of cast_builder
 	 */
 	auto insert_lhs_cast(cast_builder auto&& builder = {}) -> void {
-	    _lhs = std::invoke(builder, std::move(_lhs));
+	    _lhs = std::invoke(builder, _lhs);
 	}
 
 	/**
@@ -69,7 +68,7 @@ namespace ast {
 	 * @param builder an instance of cast_builder
 	 */
 	auto insert_rhs_cast(cast_builder auto&& builder = {}) -> void {
-	    _rhs = std::invoke(builder, std::move(_rhs));
+	    _rhs = std::invoke(builder, _rhs);
 	}
     };
 
@@ -1,7 +1,5 @@
 #pragma once
 
-#include <vector>
-
 #include "expression.hpp"
 #include "implicit_cast.hpp"
 
@@ -12,14 +10,14 @@ namespace ast {
      */
     class block_expression : public expression {
     private:
-	std::vector<std::unique_ptr<expression>> _expressions; ///< expressions of block
+	expression_list _expressions; ///< expressions of block
 
     public:
 	/*
 	 * Constructor of block expression
 	 * @param expressions a vector of expressions that will be held by block
 	 */
-	block_expression(std::vector<std::unique_ptr<expression>>&& expressions);
+	block_expression(expression_list&& expressions);
 
 	[[nodiscard]] virtual auto accept(value_visitor *) const -> llvm::Value* override;
 	[[nodiscard]] virtual auto accept(type_visitor *) -> types::type* override;
@@ -28,7 +26,7 @@ namespace ast {
 	 * Accessor of expression for block_expression
 	 * @return a vector of pointers to expressions
 	 */
-	[[nodiscard]] auto expressions() const -> const std::vector<std::unique_ptr<expression>>&;
+	[[nodiscard]] auto expressions() const -> const expression_list&;
 
 	/**
 	 * Insert new expression, instead of last one (return expression), that will hold old expression
@@ -36,7 +34,7 @@ namespace ast {
 	 * @param builder an instance of cast_builder
 	 */
 	auto insert_result_cast(cast_builder auto&& builder = {}) -> void {
-	    _expressions.back() = std::invoke(builder, std::move(_expressions.back()));
+	    _expressions.back() = std::invoke(builder, _expressions.back());
 	}
     };
 
@@ -1,11 +1,8 @@
 #pragma once
 
-#include <memory>
-#include <string>
-#include <vector>
-
 #include "expression.hpp"
 #include "implicit_cast.hpp"
+#include "interner.hpp"
 
 namespace ast {
 
@@ -14,8 +11,8 @@ namespace ast {
      */
     class call_expression : public expression {
     private:
-	std::string _callee; ///< callee i.e. function name
-	std::vector<std::unique_ptr<expression>> _args; ///< arguments that are passed to the function
+	symbol _callee; ///< callee i.e. function name
+	expression_list _args; ///< arguments that are passed to the function
 
     public:
 	/**
@@ -23,7 +20,7 @@ namespace ast {
 	 * @param callee a function name
 	 * @param args a vector of expressions that are passed to the function
 	 */
-	call_expression(std::string&& callee, std::vector<std::unique_ptr<expression>>&& args);
+	call_expression(symbol callee, expression_list&& args);
 
 	[[nodiscard]] virtual auto accept(value_visitor*) const -> llvm::Value* override;
 	[[nodiscard]] virtual auto accept(type_visitor*) -> types::type* override;
@@ -32,19 +29,19 @@ namespace ast {
 	 * Accessor of callee for call expression
 	 * @return function name
 	 */
-	[[nodiscard]] auto callee() const -> const std::string&;
+	[[nodiscard]] auto callee() const -> symbol;
 
 	/**
 	 * Accessor of args for const call expression
 	 * @return const reference to the vector of arguments
 	 */
-	[[nodiscard]] auto args() const -> const std::vector<std::unique_ptr<expression>>&;
+	[[nodiscard]] auto args() const -> const expression_list&;
 
 	/**
 	 * Accessor of args for non-const call expression
 	 * @return reference to the vector of arguments
 	 */
-	[[nodiscard]] auto args()       ->       std::vector<std::unique_ptr<expression>>&;
+	[[nodiscard]] auto args()       ->       expression_list&;
 
 	/**
 	 * Insert new expressions, instead of specified argument, that will hold old expression
@@ -53,11 +50,11 @@ namespace ast {
 	 * @param builder an instance of cast_builder
 	 */
 	auto insert_arg_cast(
-		typename std::vector<std::unique_ptr<expression>>::const_iterator it,
+		expression_list::const_iterator it,
 		cast_builder auto&& builder = {}) 
 	    -> void {
 	    auto iter = std::ranges::next(_args.begin(), it);
-	    *iter = std::invoke(builder, std::move(*iter));
+	    *iter = std::invoke(builder, *iter);
 	}
     };
 
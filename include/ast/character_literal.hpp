@@ -1,7 +1,7 @@
 #pragma once
 
 #include <cstdint>
-#include <string>
+#include <string_view>
 
 #include "expression.hpp"
 
@@ -19,7 +19,7 @@ namespace ast {
 	 * Constructor of character_literal_expression
 	 * @param value a string of 1 element that holds value
 	 */
-	character_literal_expression(std::string&& value);
+	character_literal_expression(std::string_view value);
 
 	[[nodiscard]] virtual auto accept(value_visitor*) const -> llvm::Value* override;
 	[[nodiscard]] virtual auto accept(type_visitor*) -> types::type* override;
@@ -2,6 +2,8 @@
 
 #include <concepts>
 #include <memory>
+#include <memory_resource>
+#include <vector>
 
 #include <llvm/IR/Value.h>
 #include <llvm/IR/Type.h>
@@ -52,4 +54,9 @@ namespace ast {
 	[[nodiscard]] virtual auto accept(type_visitor* v) -> types::type* = 0;
     };
 
+    /**
+     * List of child expressions, allocated inside of the arena that owns the nodes
+     */
+    using expression_list = std::pmr::vector<expression*>;
+
 }
@@ -1,13 +1,13 @@
 #pragma once
 
-#include <memory>
-#include <string>
-#include <vector>
+#include <cstdint>
+#include <memory_resource>
 
 #include <llvm/IR/Function.h>
 
 #include "expression.hpp"
 #include "block.hpp"
+#include "interner.hpp"
 
 namespace ast {
 
@@ -16,11 +16,13 @@ namespace ast {
      */
     class function_expression : public expression {
     private:
-	std::string _name;			 ///< name of function
-	std::vector<std::string> _args;          ///< names of arguments
-	std::vector<std::string> _types;         ///< types of arguments
-	std::string _ret_type;                   ///< return type of function
-	std::unique_ptr<block_expression> _body; ///< body of function that is block expression
+	symbol _name;                            ///< name of function
+	std::pmr::vector<symbol> _args;          ///< names of arguments
+	std::pmr::vector<symbol> _types;         ///< types of arguments
+	symbol _ret_type;                        ///< return type of function
+	block_expression* _body;                 ///< body of function that is block expression
+	uint64_t _fingerprint;                   ///< hash of tokens of function definition
+	std::pmr::vector<symbol> _callees;       ///< names of called functions, in order of calls
 
     public:
 	/**
@@ -30,10 +32,13 @@ namespace ast {
 	 * @param type_list a vector of arguments' types
 	 * @param return_type a return type of a function
 	 * @param body a block expression that is a body of a function
+	 * @param fingerprint a hash of tokens of function definition
+	 * @param callees a vector of names of called functions
 	 */
-	function_expression(std::string&& name, std::vector<std::string>&& args,
-		std::vector<std::string>&& type_list, std::string&& return_type,
-		std::unique_ptr<block_expression>&& body);
+	function_expression(symbol name, std::pmr::vector<symbol>&& args,
+		std::pmr::vector<symbol>&& type_list, symbol return_type,
+		block_expression* body, uint64_t fingerprint,
+		std::pmr::vector<symbol>&& callees);
 
 	[[nodiscard]] virtual auto accept(value_visitor* v) const -> llvm::Value* override;
 	[[nodiscard]] virtual auto accept(type_visitor* v) -> types::type* override;
@@ -42,25 +47,25 @@ namespace ast {
 	 * Accessor of name for function
 	 * @return name of a function
 	 */
-	[[nodiscard]] auto name()        const -> const std::string&;
+	[[nodiscard]] auto name()        const -> symbol;
 
 	/**
 	 * Accessor of arguments for const function
 	 * @return arguments' names of a function
 	 */
-	[[nodiscard]] auto args()        const -> const std::vector<std::string>&;
+	[[nodiscard]] auto args()        const -> const std::pmr::vector<symbol>&;
 
 	/**
 	 * Accessor of types for const function
 	 * @return arguments' types of a function
 	 */
-	[[nodiscard]] auto types()       const -> const std::vector<std::string>&;
+	[[nodiscard]] auto types()       const -> const std::pmr::vector<symbol>&;
 
 	/**
 	 * Accessor of return type for const function
 	 * @return return type of a function
 	 */
-	[[nodiscard]] auto return_type() const -> const std::string&;
+	[[nodiscard]] auto return_type() const -> symbol;
 
 	/**
 	 * Accessor of body for cosnt function
@@ -73,6 +78,20 @@ namespace ast {
 	 * @return block of body of function
 	 */
 	[[nodiscard]] auto body()              ->       block_expression*;
+
+	/**
+	 * Accessor of fingerprint for function, equal fingerprints mean equal token streams of definitions
+	 * @return hash of tokens of function definition
+	 */
+	[[nodiscard]] auto fingerprint() const -> uint64_t;
+
+	/**
+	 * Accessor of callees for function
+	 * @return names of functions called from body, may repeat
+	 */
+	[[nodiscard]] auto callees()     const -> const std::pmr::vector<symbol>&;
     };
 
+    using function_list = std::pmr::vector<function_expression*>; ///< functions of one module in order of definition
+
 }
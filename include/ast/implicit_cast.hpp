@@ -15,9 +15,9 @@ namespace ast {
      * @tparam F type of object to test
      */
     template<typename F>
-    concept cast_builder = std::invocable<F, std::unique_ptr<expression>&&> &&
-    requires(F f, std::unique_ptr<expression>&& e) {
-	{ std::invoke(f, std::move(e)) } -> std::same_as<std::unique_ptr<implicit_cast>>;
+    concept cast_builder = std::invocable<F, expression*> &&
+    requires(F f, expression* e) {
+	{ std::invoke(f, e) } -> std::same_as<implicit_cast*>;
     };
 
 
@@ -26,7 +26,7 @@ namespace ast {
      */
     class implicit_cast : public expression {
     private:
-	std::unique_ptr<expression> _subject; ///< expression to cast
+	expression* _subject; ///< expression to cast
 
     public:
 	/**
@@ -34,7 +34,7 @@ namespace ast {
 	 * @param subj an expression to cast
 	 * @param to a type of resulting expression
 	 */
-	implicit_cast(std::unique_ptr<expression>&& subj, types::type* to);
+	implicit_cast(expression* subj, types::type* to);
 
 	[[nodiscard]] virtual auto accept(value_visitor*) const -> llvm::Value* override;
 	[[nodiscard]] virtual auto accept(type_visitor*) -> types::type* override;
@@ -1,45 +1,45 @@
 #pragma once
 
 #include <cstdint>
-#include <string>
+#include <string_view>
 
 #include "expression.hpp"
+#include "integer_value.hpp"
 
 namespace ast {
 
-    class integer_container : public std::string {
-    public:
-	template<typename T>
-	integer_container(T&& o) : std::string(std::forward<T&&>(o)) {}
-
-	[[nodiscard]] auto operator<=>(const integer_container& o) const -> std::strong_ordering;
-	[[nodiscard]] auto operator<=>(const std::string& o) const -> std::strong_ordering;
-    };
-
     /**
      * Integer value literal expression
      */
     class integer_literal_expression : public expression {
     private:
-	integer_container _value; ///< value of the literal
-	uint8_t _radix; ///< radix of literal
+	std::string_view _text; ///< digits of the literal, view into the source buffer
+	integer_value _value;   ///< value of the literal, converted once by parser
+	uint8_t _radix;         ///< radix of literal
 
     public:
 	/**
 	 * Constructor of integer_literal_expression 
-	 * @param value a string that represents integer value
+	 * @param text a digits of literal as they are written in source
+	 * @param value a value of digits
 	 * @param radix a radix of literal i.e. 2, 8, 10, 16
 	 */
-	integer_literal_expression(std::string&& value, uint8_t radix);
+	integer_literal_expression(std::string_view text, integer_value value, uint8_t radix);
 
 	[[nodiscard]] virtual auto accept(value_visitor*) const -> llvm::Value* override;
 	[[nodiscard]] virtual auto accept(type_visitor*) -> types::type* override;
 
+	/**
+	 * Accessor of digits for integer literal
+	 * @return digits as they are written in source
+	 */
+	[[nodiscard]] auto text() const -> std::string_view;
+
 	/**
 	 * Accessor of value for integer literal
-	 * @return integer_container value of literal
+	 * @return value of literal
 	 */
-	[[nodiscard]] auto value() const -> const integer_container&;
+	[[nodiscard]] auto value() const -> const integer_value&;
 
 	/**
 	 * Accessor of radix for integer literal
@@ -1,7 +1,7 @@
 #pragma once
 
 #include <cstdint>
-#include <string>
+#include <string_view>
 
 #include "expression.hpp"
 
@@ -12,14 +12,14 @@ namespace ast {
      */
     class string_literal_expression : public expression {
     private:
-	std::string _value; ///< value of literal
+	std::string_view _value; ///< value of literal, view into the source buffer
 
     public:
 	/**
 	 * Constructor of string_literal_expression
 	 * @param value a string that represents value of literal
 	 */
-	string_literal_expression(std::string&& value);
+	string_literal_expression(std::string_view value);
 
 	[[nodiscard]] virtual auto accept(value_visitor*) const -> llvm::Value* override;
 	[[nodiscard]] virtual auto accept(type_visitor*) -> types::type* override;
@@ -28,7 +28,7 @@ namespace ast {
 	 * Accessor of value for string literal
 	 * @return value of literal
 	 */
-	[[nodiscard]] auto value() const -> const std::string&;
+	[[nodiscard]] auto value() const -> std::string_view;
     };
 
 }
@@ -1,8 +1,7 @@
 #pragma once
 
-#include <string>
-
 #include "expression.hpp"
+#include "interner.hpp"
 
 namespace ast {
 
@@ -11,23 +10,23 @@ namespace ast {
      */
     class variable_expression : public expression {
     private:
-	std::string _name; ///< name of variable
+	symbol _name; ///< name of variable
 
     public:
 	/**
 	 * Constructor for variable
 	 * @param name a name of variable
 	 */
-	variable_expression(std::string&& name);
+	variable_expression(symbol name);
 
 	[[nodiscard]] virtual auto accept(value_visitor*) const -> llvm::Value* override;
 	[[nodiscard]] virtual auto accept(type_visitor*) -> types::type* override;
 
 	/**
 	 * Accessor of name for const variable_expression
-	 * @return const reference to the name
+	 * @return interned name
 	 */
-	[[nodiscard]] auto name() const -> const std::string&;
+	[[nodiscard]] auto name() const -> symbol;
     };
 
 }
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+/**
+ * Classes of characters recognised by lexer, one bit per class
+ */
+namespace char_class {
+    enum : uint8_t {
+	blank        = 1 << 0, ///< ' ', '\t', '\v', '\f'
+	eol          = 1 << 1, ///< '\n', '\r'
+	alpha        = 1 << 2, ///< [a-zA-Z_]
+	digit        = 1 << 3, ///< [0-9]
+	hex_letter   = 1 << 4, ///< [a-fA-F]
+	special      = 1 << 5, ///< symbols that form operators
+	punctuation  = 1 << 6, ///< symbols that cannot be overriden i.e. brackets, ',' and '.'
+    };
+}
+
+/**
+ * Build table of classes for all 256 values of char
+ */
+[[nodiscard]] constexpr auto make_char_classes() noexcept -> std::array<uint8_t, 256> {
+    std::array<uint8_t, 256> classes{};
+
+    for(unsigned char ch: {' ', '\t', '\v', '\f'})
+	classes[ch] |= char_class::blank;
+    for(unsigned char ch: {'\n', '\r'})
+	classes[ch] |= char_class::eol;
+    for(unsigned char ch = 'a'; ch <= 'z'; ++ch)
+	classes[ch] |= char_class::alpha;
+    for(unsigned char ch = 'A'; ch <= 'Z'; ++ch)
+	classes[ch] |= char_class::alpha;
+    classes['_'] |= char_class::alpha;
+    for(unsigned char ch = '0'; ch <= '9'; ++ch)
+	classes[ch] |= char_class::digit;
+    for(unsigned char ch = 'a'; ch <= 'f'; ++ch)
+	classes[ch] |= char_class::hex_letter;
+    for(unsigned char ch = 'A'; ch <= 'F'; ++ch)
+	classes[ch] |= char_class::hex_letter;
+    for(unsigned char ch: {'!', '#', '$', '%', '&', '*', '+', '-', '/', ':', ';', '<', '=', '>', '?', '@', '^', '~'})
+	classes[ch] |= char_class::special;
+    for(unsigned char ch: {'(', ')', '[', ']', '{', '}', ',', '.'})
+	classes[ch] |= char_class::punctuation;
+
+    return classes;
+}
+
+inline constexpr std::array<uint8_t, 256> char_classes = make_char_classes(); ///< class of every char value
+
+/**
+ * Check if character belongs to any of given classes
+ * @param ch a character to check
+ * @param classes a bitwise or of char_class values
+ */
+[[nodiscard]] constexpr auto has_class(char ch, uint8_t classes) noexcept -> bool {
+    return char_classes[static_cast<unsigned char>(ch)] & classes;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "lexer.hpp"
+#include "token_stream.hpp"
+
+/**
+ * Lexer of large sources that splits them into chunks at line boundaries and lexes chunks in parallel.
+ * Every chunk is lexed speculatively, as if it started outside of comments and string literals.
+ * Chunks are then stitched in order: where lexing of previous chunk ran past the boundary,
+ * e.g. in the middle of multi-line comment, tokens are lexed again from the real position
+ * until they meet a token boundary of the speculative chunk, the rest of the chunk is taken as is
+ */
+namespace chunk_lexer {
+
+    inline constexpr std::size_t min_chunk = 256 * 1024; ///< smallest chunk worth a thread of its own
+
+    /**
+     * Lex whole source
+     * @param source a lexer that owns source, it is only used to share the source with chunk lexers
+     * @param threads a maximum number of chunks lexed at once, 0 means number of hardware threads
+     * @return all tokens of source, the last one is eof
+     */
+    [[nodiscard]] auto lex(const lexer& source, unsigned threads) -> std::vector<token_record>;
+
+}
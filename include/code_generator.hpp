@@ -9,16 +9,37 @@
 #include <llvm/IR/IRBuilder.h>
 
 #include "ast.hpp"
+#include "interner.hpp"
+#include "optimizer.hpp"
+#include "types.hpp"
 
+/**
+ * Generator of LLVM IR from analysed AST.
+ * By default IR is generated in LLVMContext of the thread that created generator, so generators may run on different threads
+ */
 class code_generator : public ast::value_visitor {
 private:
-    std::unique_ptr<llvm::LLVMContext> _context;
+    llvm::LLVMContext& _context;
     std::unique_ptr<llvm::Module> _module;
     std::unique_ptr<llvm::IRBuilder<>> _builder;
-    std::unordered_map<std::string, llvm::Value*> _named_values{};
+    std::unordered_map<symbol, llvm::Value*> _named_values{};
+    optimizer* _optimizer;
 
 public:
-    code_generator(const std::string&);
+    /**
+     * Constructor of generator
+     * @param module_name a name of generated module
+     * @param function_optimizer an optimizer that runs function pipeline on every generated function, nullptr leaves them as generated
+     */
+    code_generator(const std::string& module_name, optimizer* function_optimizer = nullptr);
+
+    /**
+     * Constructor of generator that generates IR in given context
+     * @param module_name a name of generated module
+     * @param function_optimizer an optimizer that runs function pipeline on every generated function, nullptr leaves them as generated
+     * @param context a context that owns generated module, it must not be used by other threads meanwhile
+     */
+    code_generator(const std::string& module_name, optimizer* function_optimizer, llvm::LLVMContext& context);
 
     code_generator()                      = delete;
     code_generator(const code_generator&) = delete;
@@ -27,6 +48,24 @@ public:
     auto operator=(code_generator&&)      = delete;
     ~code_generator()                     = default;
 
+    /**
+     * Declare function defined elsewhere, so that calls to it can be generated
+     * @param name a name of a function
+     * @param type a type of a function
+     * @return declaration of function in generated module
+     */
+    auto declare_function(symbol name, types::function_type* type) -> llvm::Function*;
+
+    /**
+     * Accessor of generated module
+     */
+    [[nodiscard]] auto get_module() const -> const llvm::Module&;
+
+    /**
+     * Take generated module, nothing may be generated afterwards
+     */
+    [[nodiscard]] auto release_module() -> std::unique_ptr<llvm::Module>;
+
     virtual auto visit(const ast::expression*)                   -> llvm::Value* override;
     virtual auto visit(const ast::integer_literal_expression*)   -> llvm::Value* override;
     virtual auto visit(const ast::floating_literal_expression*)  -> llvm::Value* override;
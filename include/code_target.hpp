@@ -0,0 +1,69 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <llvm/IR/DataLayout.h>
+#include <llvm/IR/Module.h>
+#include <llvm/MC/TargetRegistry.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Target/TargetMachine.h>
+
+#include "optimizer.hpp"
+
+/**
+ * Target of machine code generation: triple, CPU and its features.
+ * Modules are given triple and data layout of target before they are optimized, so that
+ * optimizations see sizes and alignments of the machine, and are then emitted as object files.
+ * Every emission creates its own TargetMachine, so one target may emit from several threads at once
+ */
+class code_target {
+private:
+    const llvm::Target* _target; ///< registered backend of triple
+    std::string _triple;         ///< normalized target triple
+    std::string _cpu;            ///< name of CPU, empty for generic one
+    std::string _features;       ///< comma separated features of CPU, e.g. +avx2,-sse4a
+    opt_level _level;            ///< optimization level of machine code generator
+    llvm::DataLayout _layout;    ///< data layout of target
+
+    code_target(const llvm::Target* target, std::string triple, std::string cpu, std::string features, opt_level level, llvm::DataLayout layout);
+
+public:
+    code_target()                              = delete;
+    code_target(const code_target&)            = delete;
+    code_target(code_target&&)                 = delete;
+    auto operator=(const code_target&)         = delete;
+    auto operator=(code_target&&)              = delete;
+    ~code_target()                             = default;
+
+    /**
+     * Find backend of target
+     * @param triple a target triple, empty for host
+     * @param cpu a name of CPU, "native" for CPU of host together with its features
+     * @param features a comma separated list of features added to or removed from CPU, e.g. +avx2,-sse4a
+     * @param level an optimization level of machine code generator
+     * @return target or nullptr if triple or CPU is unknown, error is printed
+     */
+    [[nodiscard]] static auto create(std::string triple, std::string cpu, std::string features, opt_level level) -> std::unique_ptr<code_target>;
+
+    /**
+     * Set triple and data layout of module to those of target
+     */
+    auto apply(llvm::Module& module) const -> void;
+
+    /**
+     * Generate machine code of module and write it as relocatable object file
+     * @param module a module to emit, triple and data layout are set if they are not yet
+     * @param out a stream to write object file to
+     * @return false if target cannot emit object files, error is printed
+     */
+    [[nodiscard]] auto emit_object(llvm::Module& module, llvm::raw_pwrite_stream& out) const -> bool;
+
+    /**
+     * Get canonical text of target, it is a part of keys of cached modules
+     */
+    [[nodiscard]] auto configuration() const -> std::string;
+
+private:
+    [[nodiscard]] auto machine() const -> std::unique_ptr<llvm::TargetMachine>;
+};
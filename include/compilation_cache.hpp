@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include <llvm/ADT/StringRef.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include "optimizer.hpp"
+#include "tables.hpp"
+
+/**
+ * Content-addressed cache of compiled modules in a local directory.
+ * Entries are keyed by SHA-256 of compiler version, operator table, optimization, module name and source bytes,
+ * so any change of input produces a new entry and stale entries are never returned.
+ * Directory is bounded by size, least recently used entries are evicted first. Size of directory is scanned
+ * when cache is opened and then estimated from stored entries, directory is scanned again only when estimate exceeds bound,
+ * so entries written by other processes are noticed at the next scan.
+ * Entries are written to temporary files and renamed, so several processes may share one directory
+ */
+class compilation_cache {
+private:
+    std::string _directory;             ///< directory that holds entries
+    uint64_t _max_bytes;                ///< maximum total size of entries
+    std::mutex _eviction_mutex;         ///< serialises eviction of threads of one process
+    std::atomic<uint64_t> _hits{0};     ///< lookups that found entry
+    std::atomic<uint64_t> _misses{0};   ///< lookups that found nothing
+    std::atomic<uint64_t> _stores{0};   ///< entries written
+    std::atomic<uint64_t> _evictions{0};///< entries removed to stay within size
+    std::atomic<uint64_t> _estimated_bytes{0}; ///< size of directory at last scan plus entries stored since
+
+public:
+    /**
+     * Constructor of cache
+     * @param directory a directory of entries, created if missing
+     * @param max_bytes a maximum total size of entries
+     */
+    compilation_cache(std::string directory, uint64_t max_bytes);
+
+    compilation_cache()                                   = delete;
+    compilation_cache(const compilation_cache&)           = delete;
+    compilation_cache(compilation_cache&&)                = delete;
+    auto operator=(const compilation_cache&)              = delete;
+    auto operator=(compilation_cache&&)                   = delete;
+    ~compilation_cache()                                  = default;
+
+    /**
+     * Compute key of compilation
+     * @param source a source text
+     * @param configuration a canonical text of operator table and optimization
+     * @param module_name a name of generated module, it is stored inside of module
+     * @return hexadecimal SHA-256 digest
+     */
+    [[nodiscard]] static auto key(std::string_view source, std::string_view configuration, std::string_view module_name) -> std::string;
+
+    /**
+     * Get canonical text of operator table and optimization settings, it is a part of every key
+     */
+    [[nodiscard]] static auto configuration(const operator_table& operators, const optimization& opt) -> std::string;
+
+    /**
+     * Compute key of compilation of one function
+     * @param configuration a canonical text of operator table and optimization
+     * @param function a description of function that changes with its tokens and signatures of its callees
+     * @return hexadecimal SHA-256 digest
+     */
+    [[nodiscard]] static auto function_key(std::string_view configuration, std::string_view function) -> std::string;
+
+    /**
+     * Find cached entry and mark it as recently used
+     * @param key a key of compilation
+     * @return content of entry or nullptr if there is none
+     */
+    [[nodiscard]] auto lookup(const std::string& key) -> std::unique_ptr<llvm::MemoryBuffer>;
+
+    /**
+     * Store entry and evict least recently used entries if estimated size of cache grew over its bound
+     * @param key a key of compilation
+     * @param data a content of entry
+     */
+    auto store(const std::string& key, llvm::StringRef data) -> void;
+
+    /**
+     * Remove entry, e.g. if its content turned out to be corrupted
+     */
+    auto remove(const std::string& key) -> void;
+
+    /**
+     * Print hit and miss statistics of this process
+     */
+    auto print_statistics(llvm::raw_ostream& out) const -> void;
+
+private:
+    [[nodiscard]] auto path(const std::string& key) const -> std::string;
+
+    auto evict() -> void;
+};
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <string_view>
+
+#include "frontend.hpp"
+
+/**
+ * Long-running server that compiles sources sent as JSON lines.
+ * Frontend with its builtin types, operator table and optional cache is shared by all requests,
+ * every request is compiled in its own LLVMContext that is released together with generated module.
+ *
+ * Request:  {"id": any, "name": "module", "source": "text" | "path": "file", "emit": "ll" | "bc" | "obj"}
+ * Response: {"id": any, "status": "ok", "output": "IR text or base64 of bitcode or object file"}
+ *           {"id": any, "status": "error", "error": "message"}
+ * Request {"shutdown": true} stops the server after it is answered, connected clients are disconnected.
+ * Diagnostics of failed compilations are printed to standard error of the server.
+ *
+ * Spellings of identifiers are interned for lifetime of process and are never released,
+ * so memory of server grows with number of distinct identifiers of all requests, not with number of requests
+ */
+class compile_server {
+private:
+    const frontend& _frontend;        ///< compiler of all requests
+    const code_target* _target;       ///< target of object files, nullptr if they cannot be requested
+    std::atomic<bool> _stopped{false}; ///< shutdown was requested
+    int _listener{-1};                ///< listening socket, -1 if server reads a single stream
+    int _wakeup[2]{-1, -1};           ///< pipe that wakes up poll loop of listening server when it is stopped
+
+public:
+    /**
+     * Constructor of compile server
+     * @param compiler a frontend that compiles every request
+     * @param target a target of requested object files, it should be the target of compiler
+     */
+    compile_server(const frontend& compiler, const code_target* target = nullptr);
+
+    compile_server()                              = delete;
+    compile_server(const compile_server&)         = delete;
+    compile_server(compile_server&&)              = delete;
+    auto operator=(const compile_server&)         = delete;
+    auto operator=(compile_server&&)              = delete;
+    ~compile_server()                             = default;
+
+    /**
+     * Answer requests read from input until end of input or shutdown
+     * @param input a file descriptor to read requests from
+     * @param output a file descriptor to write responses to
+     */
+    auto serve(int input, int output) -> void;
+
+    /**
+     * Accept connections on Unix domain socket and answer their requests on a thread pool.
+     * Connections are polled by one thread and only complete requests are handed to pool,
+     * so idle clients hold no worker. Requests of one connection are answered in order
+     * @param path a path of socket, existing file is replaced
+     * @param threads a number of requests compiled at once, 0 means number of hardware threads
+     * @return false if socket could not be created
+     */
+    [[nodiscard]] auto listen(const std::string& path, unsigned threads) -> bool;
+
+    /**
+     * Answer one request
+     * @param request a JSON object of request
+     * @return JSON object of response, without trailing new line
+     */
+    [[nodiscard]] auto handle(std::string_view request) -> std::string;
+
+private:
+    auto stop() -> void;
+};
@@ -0,0 +1,362 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * Transparent hash for keys of tables.
+ * Equal values of different types hash the same, so that tables can be
+ * searched by std::string_view, std::span, etc. without building a key
+ */
+struct table_hash {
+    using is_transparent = void;
+
+    template<typename T>
+    [[nodiscard]] auto operator()(const T& value) const noexcept -> std::size_t {
+	if constexpr(std::is_convertible_v<const T&, std::string_view>)
+	    return mix(std::hash<std::string_view>{}(value));
+	else if constexpr(std::is_integral_v<T> || std::is_enum_v<T>)
+	    return mix(static_cast<std::size_t>(value));
+	else if constexpr(std::is_pointer_v<T>)
+	    return mix(reinterpret_cast<std::uintptr_t>(value));
+	else if constexpr(requires { value.first; value.second; })
+	    return combine((*this)(value.first), (*this)(value.second));
+	else if constexpr(std::ranges::range<T>) {
+	    std::size_t seed = mix(std::ranges::size(value));
+	    for(const auto& element: value)
+		seed = combine(seed, (*this)(element));
+	    return seed;
+	} else
+	    return mix(std::hash<T>{}(value));
+    }
+
+private:
+    /**
+     * Spread entropy of value over all bits, so that sequential ids and aligned pointers do not collide
+     */
+    [[nodiscard]] static constexpr auto mix(std::size_t value) noexcept -> std::size_t {
+	value ^= value >> 33;
+	value *= 0xff51afd7ed558ccdULL;
+	value ^= value >> 33;
+	value *= 0xc4ceb9fe1a85ec53ULL;
+	value ^= value >> 33;
+	return value;
+    }
+
+    [[nodiscard]] static constexpr auto combine(std::size_t seed, std::size_t value) noexcept -> std::size_t {
+	return mix(seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2)));
+    }
+};
+
+/**
+ * Transparent equality for keys of tables, counterpart of table_hash
+ */
+struct table_equal {
+    using is_transparent = void;
+
+    template<typename L, typename R>
+    [[nodiscard]] auto operator()(const L& lhs, const R& rhs) const noexcept -> bool {
+	if constexpr(std::is_convertible_v<const L&, std::string_view> && std::is_convertible_v<const R&, std::string_view>)
+	    return std::string_view{lhs} == std::string_view{rhs};
+	else if constexpr(requires { lhs.first; rhs.first; })
+	    return (*this)(lhs.first, rhs.first) && (*this)(lhs.second, rhs.second);
+	else if constexpr(std::ranges::range<L> && std::ranges::range<R>)
+	    return std::ranges::equal(lhs, rhs, *this);
+	else
+	    return lhs == rhs;
+    }
+};
+
+/**
+ * Open addressing hash map with linear probing.
+ * Elements live in one flat array, next to a parallel array of one byte tags,
+ * so lookups touch one or two cache lines instead of walking a tree.
+ * Iterators and references are invalidated by insertion
+ */
+template<typename Key, typename Value, typename Hash = table_hash, typename KeyEqual = table_equal>
+class flat_hash_map {
+public:
+    using key_type    = Key;
+    using mapped_type = Value;
+    using value_type  = std::pair<const Key, Value>;
+    using size_type   = std::size_t;
+
+private:
+    static constexpr uint8_t empty_tag = 0;         ///< tag of a slot without element, occupied slots always have high bit set
+    static constexpr size_type min_capacity = 8;
+
+    std::unique_ptr<uint8_t[]> _tags{};             ///< tag of every slot i.e. 7 bits of hash or empty_tag
+    value_type* _slots{};                           ///< uninitialised storage for elements
+    size_type _capacity{};                          ///< number of slots, always a power of 2 or 0
+    size_type _size{};                              ///< number of elements
+    [[no_unique_address]] Hash _hash{};
+    [[no_unique_address]] KeyEqual _equal{};
+
+    template<bool Const>
+    class basic_iterator {
+	using map_type = std::conditional_t<Const, const flat_hash_map, flat_hash_map>;
+
+	map_type* _map{};
+	size_type _index{};
+
+    public:
+	using iterator_category = std::forward_iterator_tag;
+	using value_type        = flat_hash_map::value_type;
+	using difference_type   = std::ptrdiff_t;
+	using reference         = std::conditional_t<Const, const value_type&, value_type&>;
+	using pointer           = std::conditional_t<Const, const value_type*, value_type*>;
+
+	basic_iterator() = default;
+	basic_iterator(map_type* map, size_type index) : _map{map}, _index{index} { skip_empty(); }
+	template<bool C = Const> requires C
+	basic_iterator(const basic_iterator<false>& other) : _map{other._map}, _index{other._index} {}
+
+	auto operator*()  const -> reference { return _map->_slots[_index]; }
+	auto operator->() const -> pointer   { return &_map->_slots[_index]; }
+
+	auto operator++() -> basic_iterator& { ++_index; skip_empty(); return *this; }
+	auto operator++(int) -> basic_iterator { auto copy = *this; ++*this; return copy; }
+
+	auto operator==(const basic_iterator& other) const -> bool { return _index == other._index; }
+
+    private:
+	friend class flat_hash_map;
+	friend class basic_iterator<true>;
+
+	auto skip_empty() -> void {
+	    while(_index < _map->_capacity && _map->_tags[_index] == empty_tag)
+		++_index;
+	}
+    };
+
+public:
+    using iterator       = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    flat_hash_map() = default;
+
+    flat_hash_map(std::initializer_list<value_type> values) {
+	reserve(values.size());
+	for(const auto& value: values)
+	    try_emplace(value.first, value.second);
+    }
+
+    flat_hash_map(const flat_hash_map& other) {
+	reserve(other._size);
+	for(const auto& [key, value]: other)
+	    try_emplace(key, value);
+    }
+
+    flat_hash_map(flat_hash_map&& other) noexcept
+	: _tags{std::move(other._tags)}
+	, _slots{std::exchange(other._slots, nullptr)}
+	, _capacity{std::exchange(other._capacity, 0)}
+	, _size{std::exchange(other._size, 0)}
+    {}
+
+    auto operator=(const flat_hash_map& other) -> flat_hash_map& {
+	if(this != &other) {
+	    flat_hash_map copy{other};
+	    swap(copy);
+	}
+	return *this;
+    }
+
+    auto operator=(flat_hash_map&& other) noexcept -> flat_hash_map& {
+	flat_hash_map moved{std::move(other)};
+	swap(moved);
+	return *this;
+    }
+
+    ~flat_hash_map() {
+	clear();
+	deallocate(_slots, _capacity);
+    }
+
+    [[nodiscard]] auto begin()       noexcept -> iterator       { return {this, 0}; }
+    [[nodiscard]] auto end()         noexcept -> iterator       { return {this, _capacity}; }
+    [[nodiscard]] auto begin() const noexcept -> const_iterator { return {this, 0}; }
+    [[nodiscard]] auto end()   const noexcept -> const_iterator { return {this, _capacity}; }
+
+    [[nodiscard]] auto size()  const noexcept -> size_type { return _size; }
+    [[nodiscard]] auto empty() const noexcept -> bool      { return _size == 0; }
+
+    /**
+     * Find element by key or any value that hashes and compares equal to the key
+     * @return iterator to the element or end()
+     */
+    template<typename K>
+    [[nodiscard]] auto find(const K& key) -> iterator {
+	return {this, find_index(key)};
+    }
+
+    template<typename K>
+    [[nodiscard]] auto find(const K& key) const -> const_iterator {
+	return {this, find_index(key)};
+    }
+
+    template<typename K>
+    [[nodiscard]] auto contains(const K& key) const -> bool {
+	return find_index(key) != _capacity;
+    }
+
+    /**
+     * Insert element constructed from args if there is no element with equal key
+     * @return iterator to the element with key and true if element was inserted
+     */
+    template<typename K, typename... Args>
+    auto try_emplace(K&& key, Args&&... args) -> std::pair<iterator, bool> {
+	if(auto index = find_index(key); index != _capacity)
+	    return {iterator{this, index}, false};
+
+	reserve(_size + 1);
+	auto [index, tag] = probe_empty(key);
+	std::construct_at(_slots + index, std::piecewise_construct,
+		std::forward_as_tuple(std::forward<K>(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+	_tags[index] = tag;
+	++_size;
+	return {iterator{this, index}, true};
+    }
+
+    auto insert(value_type&& value) -> std::pair<iterator, bool> {
+	return try_emplace(std::move(const_cast<Key&>(value.first)), std::move(value.second));
+    }
+
+    template<typename K, typename V>
+    auto insert_or_assign(K&& key, V&& value) -> std::pair<iterator, bool> {
+	auto result = try_emplace(std::forward<K>(key), std::forward<V>(value));
+	if(!result.second)
+	    result.first->second = std::forward<V>(value);
+	return result;
+    }
+
+    auto operator[](const Key& key) -> Value& {
+	return try_emplace(key).first->second;
+    }
+
+    auto operator[](Key&& key) -> Value& {
+	return try_emplace(std::move(key)).first->second;
+    }
+
+    /**
+     * Remove element with key, following elements of probe sequence are shifted back
+     * @return number of removed elements
+     */
+    template<typename K>
+    auto erase(const K& key) -> size_type {
+	auto index = find_index(key);
+	if(index == _capacity)
+	    return 0;
+
+	std::destroy_at(_slots + index);
+	_tags[index] = empty_tag;
+	--_size;
+
+	size_type mask = _capacity - 1;
+	for(size_type next = (index + 1) & mask; _tags[next] != empty_tag; next = (next + 1) & mask) {
+	    size_type home = _hash(_slots[next].first) & mask;
+	    // element may fill the hole only if hole lies between its home slot and its current slot
+	    if(((next - home) & mask) < ((next - index) & mask))
+		continue;
+	    std::construct_at(_slots + index, std::move(const_cast<Key&>(_slots[next].first)), std::move(_slots[next].second));
+	    _tags[index] = _tags[next];
+	    std::destroy_at(_slots + next);
+	    _tags[next] = empty_tag;
+	    index = next;
+	}
+	return 1;
+    }
+
+    auto clear() noexcept -> void {
+	for(size_type i = 0; i < _capacity; ++i)
+	    if(_tags[i] != empty_tag) {
+		std::destroy_at(_slots + i);
+		_tags[i] = empty_tag;
+	    }
+	_size = 0;
+    }
+
+    /**
+     * Make room for given number of elements without rehashing
+     */
+    auto reserve(size_type count) -> void {
+	if(count * 8 <= _capacity * 7)
+	    return;
+
+	size_type capacity = std::max(min_capacity, _capacity);
+	while(count * 8 > capacity * 7)
+	    capacity *= 2;
+	rehash(capacity);
+    }
+
+    auto swap(flat_hash_map& other) noexcept -> void {
+	std::swap(_tags, other._tags);
+	std::swap(_slots, other._slots);
+	std::swap(_capacity, other._capacity);
+	std::swap(_size, other._size);
+    }
+
+private:
+    [[nodiscard]] static auto tag_of(std::size_t hash) noexcept -> uint8_t {
+	return static_cast<uint8_t>(0x80 | (hash >> (sizeof(std::size_t) * 8 - 7)));
+    }
+
+    template<typename K>
+    [[nodiscard]] auto find_index(const K& key) const -> size_type {
+	if(_size == 0)
+	    return _capacity;
+
+	std::size_t hash = _hash(key);
+	uint8_t tag = tag_of(hash);
+	size_type mask = _capacity - 1;
+	for(size_type index = hash & mask; _tags[index] != empty_tag; index = (index + 1) & mask)
+	    if(_tags[index] == tag && _equal(_slots[index].first, key))
+		return index;
+	return _capacity;
+    }
+
+    template<typename K>
+    [[nodiscard]] auto probe_empty(const K& key) const -> std::pair<size_type, uint8_t> {
+	std::size_t hash = _hash(key);
+	size_type mask = _capacity - 1;
+	size_type index = hash & mask;
+	while(_tags[index] != empty_tag)
+	    index = (index + 1) & mask;
+	return {index, tag_of(hash)};
+    }
+
+    auto rehash(size_type capacity) -> void {
+	auto old_tags = std::exchange(_tags, std::make_unique<uint8_t[]>(capacity));
+	auto old_slots = std::exchange(_slots, allocate(capacity));
+	auto old_capacity = std::exchange(_capacity, capacity);
+
+	for(size_type i = 0; i < old_capacity; ++i) {
+	    if(old_tags[i] == empty_tag)
+		continue;
+	    auto [index, tag] = probe_empty(old_slots[i].first);
+	    std::construct_at(_slots + index, std::move(const_cast<Key&>(old_slots[i].first)), std::move(old_slots[i].second));
+	    _tags[index] = tag;
+	    std::destroy_at(old_slots + i);
+	}
+	deallocate(old_slots, old_capacity);
+    }
+
+    [[nodiscard]] static auto allocate(size_type capacity) -> value_type* {
+	return std::allocator<value_type>{}.allocate(capacity);
+    }
+
+    static auto deallocate(value_type* slots, size_type capacity) noexcept -> void {
+	if(slots)
+	    std::allocator<value_type>{}.deallocate(slots, capacity);
+    }
+};
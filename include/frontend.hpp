@@ -0,0 +1,86 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+
+#include "code_target.hpp"
+#include "compilation_cache.hpp"
+#include "operator_precedence.hpp"
+#include "optimizer.hpp"
+#include "source_buffer.hpp"
+#include "tables.hpp"
+
+/**
+ * Entry point of compiler frontend library: source in, LLVM module out.
+ * Frontend keeps no state between compilations except builtin tables, optimization settings, optional target and cache
+ * of compiled modules, so one frontend may compile any number of sources, also from several threads at once.
+ * Diagnostics are printed to standard error and failed compilation returns nullptr
+ */
+class frontend {
+private:
+    unsigned _threads;          ///< maximum number of workers of one compilation
+    operator_table _operators;  ///< registered binary operators, part of configuration
+    operator_precedence _precedence; ///< operators compiled for lookup, shared by every parser
+    compilation_cache* _cache;  ///< cache of compiled modules and functions, nullptr if compilation is not cached
+    optimization _optimization; ///< optimization of generated functions and modules
+    const code_target* _target; ///< target whose triple and data layout are given to modules, nullptr leaves them unset
+    std::string _configuration; ///< canonical text of operator table and optimization, part of keys of cached modules and functions
+
+public:
+    /**
+     * Constructor of frontend
+     * @param threads a maximum number of workers that compile functions of one source, 0 means number of hardware threads
+     * @param cache a cache of compiled modules shared by compilations, nullptr disables caching
+     * @param opt an optimization of generated functions and modules, nothing is optimized by default
+     * @param target a target that modules are generated for, nullptr leaves modules without triple and data layout
+     * @param operators a precedence of binary operators, default ones may be extended with custom operators
+     */
+    frontend(unsigned threads = 0, compilation_cache* cache = nullptr, optimization opt = {}, const code_target* target = nullptr, operator_table operators = default_operators());
+
+    frontend(const frontend&)         = delete;
+    frontend(frontend&&)              = delete;
+    auto operator=(const frontend&)   = delete;
+    auto operator=(frontend&&)        = delete;
+    ~frontend()                       = default;
+
+    /**
+     * Compile loaded source
+     * @param source a source text to compile
+     * @param module_name a name of generated module
+     * @param context a context that will own generated module
+     * @return generated module or nullptr if source failed to compile
+     */
+    [[nodiscard]] auto compile(source_buffer&& source, std::string_view module_name, llvm::LLVMContext& context) const -> std::unique_ptr<llvm::Module>;
+
+    /**
+     * Compile source file
+     * @param path a path to source file, "-" reads standard input
+     * @param module_name a name of generated module
+     * @param context a context that will own generated module
+     * @return generated module or nullptr if file could not be read or failed to compile
+     */
+    [[nodiscard]] auto compile_file(std::string_view path, std::string_view module_name, llvm::LLVMContext& context) const -> std::unique_ptr<llvm::Module>;
+
+    /**
+     * Compile source text held in memory, text is copied
+     * @param text a source text to compile
+     * @param module_name a name of generated module
+     * @param context a context that will own generated module
+     * @return generated module or nullptr if source failed to compile
+     */
+    [[nodiscard]] auto compile_text(std::string_view text, std::string_view module_name, llvm::LLVMContext& context) const -> std::unique_ptr<llvm::Module>;
+
+    /**
+     * Get default precedence of binary operators
+     */
+    [[nodiscard]] static auto default_operators() -> operator_table;
+
+private:
+    [[nodiscard]] auto compile_uncached(source_buffer&& source, std::string_view module_name, llvm::LLVMContext& context) const -> std::unique_ptr<llvm::Module>;
+
+    [[nodiscard]] auto load_cached(const std::string& key, std::string_view module_name, llvm::LLVMContext& context) const -> std::unique_ptr<llvm::Module>;
+};
@@ -1,38 +1,66 @@
 #pragma once
 
 #include <memory>
+#include <shared_mutex>
+#include <span>
+#include <string_view>
 
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Type.h>
 
+#include "interner.hpp"
 #include "tables.hpp"
 #include "types.hpp"
 
+/**
+ * Builtin types, casts and operations shared by all compilations in process.
+ * Builtin types are built by constructor and never change afterwards, so they are read without locking.
+ * Casts and operations on builtin types are dispatched through constant tables indexed by builtin ids.
+ * Function types are created on demand under a lock.
+ * LLVM IR is never generated in context of builtin types, every thread gets its own context instead
+ */
 class global_context {
 private:
-    std::unique_ptr<llvm::LLVMContext> _context;
-    type_table _types{};
-    function_type_table _function_types{};
-    cast_table _casts{};
-    binary_operation_table _binary_operation_table{};
+    std::unique_ptr<llvm::LLVMContext> _context;                    ///< owns LLVM types of builtin and function types
+    const type_table _types;                                        ///< builtin types
+    function_type_table _function_types{};                          ///< function types, guarded by _function_types_mutex
+    std::shared_mutex _function_types_mutex{};                      ///< function types are added by concurrent compilations
 
 public:
     static auto instance() -> global_context&;
 
+    /**
+     * Get context that owns LLVM types of builtin types, must not be used to generate IR
+     */
     [[nodiscard]] auto get() -> llvm::LLVMContext&;
+
+    /**
+     * Get context of calling thread, it is created on first use and destroyed when thread exits
+     */
     [[nodiscard]] static auto context() -> llvm::LLVMContext&;
 
-    [[nodiscard]] auto get_type(const std::string&) -> types::type*;
-    [[nodiscard]] static auto type(const std::string&) -> types::type*;
+    [[nodiscard]] auto get_type(symbol) const -> types::type*;
+    [[nodiscard]] static auto type(symbol) -> types::type*;
+
+    [[nodiscard]] auto get_type(std::string_view) const -> types::type*;
+    [[nodiscard]] static auto type(std::string_view) -> types::type*;
 
-    [[nodiscard]] auto get_type(const std::vector<std::string>&, const std::string&) -> types::function_type*;
-    [[nodiscard]] static auto type(const std::vector<std::string>&, const std::string&) -> types::function_type*;
+    [[nodiscard]] auto get_type(std::span<const symbol>, symbol) -> types::function_type*;
+    [[nodiscard]] static auto type(std::span<const symbol>, symbol) -> types::function_type*;
 
-    [[nodiscard]] auto get_cast(types::type*, types::type*) -> const std::function<cast_function>&;
-    [[nodiscard]] static auto cast(types::type*, types::type*) -> const std::function<cast_function>&;
+    /**
+     * Get implicit cast between types
+     * @return cast function or nullptr if there is no such cast
+     */
+    [[nodiscard]] auto get_cast(types::type*, types::type*) const -> cast_function*;
+    [[nodiscard]] static auto cast(types::type*, types::type*) -> cast_function*;
 
-    [[nodiscard]] auto get_binary_operation(const std::string&, types::type*) -> const std::function<binary_operation_function>&;
-    [[nodiscard]] static auto binary_operation(const std::string&, types::type*) -> const std::function<binary_operation_function>&;
+    /**
+     * Get binary operation on operands of type
+     * @return operation function or nullptr if there is no such operation
+     */
+    [[nodiscard]] auto get_binary_operation(symbol, types::type*) const -> binary_operation_function*;
+    [[nodiscard]] static auto binary_operation(symbol, types::type*) -> binary_operation_function*;
 
 private:
     global_context();
@@ -42,10 +70,5 @@ private:
     auto operator=(global_context&&)      = delete;
     ~global_context()                     = default;
 
-    auto add_default_types() -> void;
-    auto add_default_casts() -> void;
-    auto add_default_operations() -> void;
-
-    auto add_int_cast(std::string&&, std::string&&) -> void;
-    auto add_fp_cast(std::string&&, std::string&&) -> void;
+    [[nodiscard]] static auto make_default_types(llvm::LLVMContext&) -> type_table;
 };
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+/**
+ * Unsigned value of integer literal of at most 128 bits.
+ * Value is stored as words, least significant first, so that it may be handed to llvm::APInt as is,
+ * and it owns no memory, so that it may be kept in AST arena
+ */
+struct integer_value {
+    std::array<uint64_t, 2> words{}; ///< words of value, least significant first
+
+    /**
+     * Get number of bits needed to represent value, 0 for zero
+     */
+    [[nodiscard]] auto bit_width() const noexcept -> unsigned;
+
+    /**
+     * Convert digits of literal to value, '_' separators are skipped.
+     * Runs of eight decimal digits are converted at once with SWAR
+     * @param digits a digits of literal without prefix of radix
+     * @param radix a radix of literal i.e. 2, 8, 10, 16
+     * @return value or std::nullopt if digits are invalid or value does not fit into 128 bits
+     */
+    [[nodiscard]] static auto parse(std::string_view digits, uint8_t radix) noexcept -> std::optional<integer_value>;
+};
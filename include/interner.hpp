@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <shared_mutex>
+#include <string_view>
+#include <vector>
+
+#include <llvm/ADT/StringMap.h>
+#include <llvm/Support/Allocator.h>
+
+/**
+ * Stable identifier of an interned spelling,
+ * equal spellings always map to the same symbol
+ */
+enum class symbol : uint32_t {};
+
+/**
+ * Process-wide table of identifiers, operator spellings and type names.
+ * Every distinct spelling is stored once and gets a dense 32-bit id,
+ * so downstream tables compare and hash integers instead of strings.
+ * Symbol 0 is always an empty spelling
+ */
+class interner {
+private:
+    mutable std::shared_mutex _mutex{};                           ///< guards both tables, interning may happen from several threads
+    llvm::StringMap<symbol, llvm::BumpPtrAllocator> _symbols{};   ///< owns spellings and maps them to symbols
+    std::vector<std::string_view> _spellings{};                   ///< spelling of each symbol, views into _symbols
+
+public:
+    static auto instance() -> interner&;
+
+    /**
+     * Get symbol of spelling, adding it to the table if it was not seen before
+     * @param spelling a text to intern
+     * @return symbol of spelling
+     */
+    [[nodiscard]] auto get_symbol(std::string_view spelling) -> symbol;
+    [[nodiscard]] static auto intern(std::string_view spelling) -> symbol;
+
+    /**
+     * Get spelling of previously interned symbol
+     * @param sym a symbol returned by get_symbol
+     * @return spelling, valid for the lifetime of the process
+     */
+    [[nodiscard]] auto get_spelling(symbol sym) const -> std::string_view;
+    [[nodiscard]] static auto spelling(symbol sym) -> std::string_view;
+
+private:
+    interner();
+    interner(const interner&)       = delete;
+    interner(interner&&)            = delete;
+    auto operator=(const interner&) = delete;
+    auto operator=(interner&&)      = delete;
+    ~interner()                     = default;
+};
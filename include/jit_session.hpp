@@ -0,0 +1,68 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+
+#include "optimizer.hpp"
+
+/**
+ * Session of ORC JIT that compiles generated modules to native code of host and runs them.
+ * All modules added to session share one dynamic library, so functions of one input file
+ * may be called from another. With lazy compilation a function is compiled when it is called first
+ */
+class jit_session {
+private:
+    /**
+     * Kind of one value passed to or returned from entry function
+     */
+    struct value_kind {
+	enum { integer, floating, none } kind; ///< class of LLVM type
+	unsigned bits;                        ///< width of type
+	bool is_signed;                       ///< integer is signed, taken from signext and zeroext attributes
+    };
+
+    std::unique_ptr<llvm::orc::LLJIT> _jit;                     ///< JIT that owns all added modules
+    bool _lazy;                                                 ///< functions are compiled on first call
+    std::vector<std::pair<std::string, std::vector<value_kind>>> _signatures{}; ///< signatures of functions of added modules, return kind is the last one
+    unsigned _calls{0};                                         ///< number of entry functions called so far, names wrappers
+
+    jit_session(std::unique_ptr<llvm::orc::LLJIT> jit, bool lazy);
+
+public:
+    jit_session()                              = delete;
+    jit_session(const jit_session&)            = delete;
+    jit_session(jit_session&&)                 = delete;
+    auto operator=(const jit_session&)         = delete;
+    auto operator=(jit_session&&)              = delete;
+    ~jit_session()                             = default;
+
+    /**
+     * Create JIT for host
+     * @param lazy a flag to compile functions on their first call instead of when module is added
+     * @param level an optimization level of machine code generator
+     * @return session or nullptr if host is not supported, error is printed
+     */
+    [[nodiscard]] static auto create(bool lazy, opt_level level = opt_level::O0) -> std::unique_ptr<jit_session>;
+
+    /**
+     * Add module to session, its functions become callable
+     * @param module a module to add
+     * @param context a context that owns module, session takes ownership of both
+     * @return false if module could not be added, e.g. it redefines function of another module
+     */
+    [[nodiscard]] auto add(std::unique_ptr<llvm::Module> module, std::unique_ptr<llvm::LLVMContext> context) -> bool;
+
+    /**
+     * Call function of added module
+     * @param entry a name of function to call
+     * @param args arguments in textual form, parsed according to types of parameters, out of range values are rejected
+     * @return result in textual form, empty if function returns nothing, std::nullopt if function could not be called
+     */
+    [[nodiscard]] auto run(const std::string& entry, const std::vector<std::string>& args) -> std::optional<std::string>;
+};
@@ -1,13 +1,16 @@
 #pragma once
 
 #include <cstdint>
-#include <map>
 #include <array>
 #include <string>
 #include <string_view>
 #include <memory>
 #include <cstdio>
 
+#include "interner.hpp"
+#include "scanner.hpp"
+#include "source_buffer.hpp"
+
 /**
  * Enumeration of all lexer tokens
  */
@@ -32,16 +35,30 @@ enum class tokens : uint8_t {
     left_curly_brace,
     right_curly_brace,
     return_token,
+    function_token,
+};
+
+/**
+ * Location of token text inside of the source buffer
+ */
+struct source_span {
+    uint32_t offset{}; ///< offset of the first character of the token from the beginning of the source
+    uint32_t length{}; ///< number of characters in the token
 };
 
 /**
  * Lexer that reads given file and produces toknes
  */
 class lexer {
-    static std::map<std::string, tokens> _tokens;                                 ///< a dictionary that maps key words to the tokens
-    std::unique_ptr<std::FILE, decltype(&std::fclose)> _file{stdin, std::fclose}; ///< a file object to read
-    tokens _current_token{};                                                      ///< previously read token
-    std::string _identifier{};                                                    ///< previously read identifier
+    source_buffer _source;                                     ///< whole source text to read
+    const scanner* _scanner{&scanner::active()};               ///< routines that skip runs of characters
+    const char* _cursor{};                                     ///< position of last character read
+    const char* _end{};                                        ///< end of source text
+    char _last{};                                              ///< last character read, but not yet consumed by a token
+    tokens _current_token{};                                   ///< previously read token
+    source_span _span{};                                       ///< location of previously read identifier
+    symbol _symbol{};                                          ///< interned previously read identifier
+    std::size_t _consumed{};                                   ///< number of tokens read so far
 
 public:
     /**
@@ -50,7 +67,24 @@ public:
      */
     lexer(std::string_view filename);
 
-    lexer()                           = default;
+    /**
+     * Constructor of lexer with already loaded source
+     * @param source a source text to read
+     */
+    lexer(source_buffer&& source);
+
+    /**
+     * Constructor of lexer that reads standard input
+     */
+    lexer();
+
+    /**
+     * Constructor of lexer that reads source of another lexer from given offset, source is shared, not copied
+     * @param other a lexer whose source is read, it must outlive new lexer
+     * @param offset an offset to start from, it must not be inside of a token, e.g. beginning of a line
+     */
+    lexer(const lexer& other, std::size_t offset);
+
     lexer(const lexer&)               = delete;
     lexer(lexer&&)                    = default;
     auto operator=(const lexer&)      = delete;
@@ -61,19 +95,54 @@ public:
      * Get previously read token
      * @return token that was just read
      */
-    [[nodiscard]] auto token() noexcept -> tokens;
+    [[nodiscard]] auto token() const noexcept -> tokens;
 
     /**
      * Get previously read identifier
-     * @return identifier that was just read
+     * @return view into the source buffer, valid as long as lexer is alive
+     */
+    [[nodiscard]] auto identifier() const noexcept -> std::string_view;
+
+    /**
+     * Get previously read identifier as interned symbol
+     * @return symbol of identifier, empty symbol if token is not an identifier
+     */
+    [[nodiscard]] auto interned() const noexcept -> symbol;
+
+    /**
+     * Get location of previously read identifier
+     * @return span of identifier in the source buffer
      */
-    [[nodiscard]] auto identifier() noexcept -> std::string&;
+    [[nodiscard]] auto span() const noexcept -> source_span;
+
+    /**
+     * Get text of the source at given location
+     * @param span a location in the source buffer
+     * @return view into the source buffer, valid as long as lexer is alive
+     */
+    [[nodiscard]] auto text(source_span span) const noexcept -> std::string_view;
 
     /**
      * Read new token from a file
      */
     auto consume() noexcept -> void;
 
+    /**
+     * Get number of tokens read so far
+     */
+    [[nodiscard]] auto token_count() const noexcept -> std::size_t;
+
+    /**
+     * Get size of the whole source text
+     */
+    [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+    /**
+     * Get offset of the first character that is not yet part of any token,
+     * state of lexer is fully determined by it, so lexers at one position read the same tokens
+     */
+    [[nodiscard]] auto position() const noexcept -> std::size_t;
+
 private:
     /**
      * Logic of reading a token from file
@@ -82,14 +151,28 @@ private:
     [[nodiscard]] auto read_token() noexcept -> enum tokens;
 
     /**
-     * Read char from file
-     * @return character that was read
+     * Read char from source buffer
+     * @return character that was read or EOF at the end of the source
      */
     [[nodiscard]] auto read_char() noexcept -> char;
 
+    /**
+     * Move to given position in source buffer
+     * @param position a pointer inside of the source buffer, or end of it
+     * @return character at the position or EOF at the end of the source
+     */
+    [[nodiscard]] auto seek(const char* position) noexcept -> char;
+
+    /**
+     * Set location of current identifier
+     * @param begin a pointer to the first character of identifier
+     * @param end a pointer past the last character of identifier
+     */
+    auto set_span(const char* begin, const char* end) noexcept -> void;
+
     /**
      * Get next character without reading it
-     * @return character that was accessed
+     * @return character that was accessed or EOF at the end of the source
      */
     [[nodiscard]] auto peek() noexcept -> char;
 
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/MemoryBuffer.h>
+
+#include "ast.hpp"
+#include "compilation_cache.hpp"
+#include "optimizer.hpp"
+#include "tables.hpp"
+
+/**
+ * Compiler of all functions of one module.
+ * Signatures of functions are collected first, after that bodies are independent,
+ * so they are analysed and generated on a thread pool. Every worker generates IR
+ * in its own LLVMContext and the resulting modules are linked into one. A single worker generates
+ * in the destination context, without cache straight into the returned module, so nothing is linked.
+ * With cache every function is generated into its own module and stored as bitcode,
+ * keyed by its tokens and signatures of its callees, so unchanged functions are not compiled again.
+ * Function pipeline, if enabled, runs on workers right after every function is generated
+ */
+class module_compiler {
+private:
+    std::string _name;                                  ///< name of generated module
+    unsigned _threads;                                  ///< maximum number of workers
+    function_symbol_table _signatures{};                ///< types of all functions in module
+    std::vector<std::unique_ptr<ast::arena>> _arenas{}; ///< arenas of workers, own implicit casts inserted into AST
+    compilation_cache* _cache;                          ///< cache of compiled functions, nullptr if they are not cached
+    std::string _configuration;                         ///< canonical operator table and optimization, part of keys of functions
+    bool _optimize_functions;                           ///< run fast function pipeline on every generated function
+
+public:
+    /**
+     * Constructor of module compiler
+     * @param name a name of generated module
+     * @param threads a maximum number of workers, 0 means number of hardware threads
+     * @param cache a cache of compiled functions, nullptr disables caching
+     * @param configuration a canonical operator table used to parse functions and optimization, see compilation_cache::configuration
+     * @param optimize_functions a flag to run fast function pipeline on every generated function
+     */
+    module_compiler(std::string name, unsigned threads = 0, compilation_cache* cache = nullptr, std::string configuration = {}, bool optimize_functions = false);
+
+    module_compiler()                              = delete;
+    module_compiler(const module_compiler&)        = delete;
+    module_compiler(module_compiler&&)             = delete;
+    auto operator=(const module_compiler&)         = delete;
+    auto operator=(module_compiler&&)              = delete;
+    ~module_compiler()                             = default;
+
+    /**
+     * Analyse functions and generate module out of them
+     * @param functions a list of functions in order of definition
+     * @param context a context that will own generated module
+     * @return generated module or nullptr if any function failed to compile
+     */
+    [[nodiscard]] auto compile(ast::function_list& functions, llvm::LLVMContext& context) -> std::unique_ptr<llvm::Module>;
+
+private:
+    using bitcode = llvm::SmallVector<char, 0>;
+    using pieces  = std::vector<bitcode>;
+
+    [[nodiscard]] auto collect_signatures(const ast::function_list&) -> bool;
+    [[nodiscard]] auto function_key(const ast::function_expression&) const -> std::string;
+
+    /**
+     * Analyse and generate pending functions until none is left, several workers may run it at once
+     * @param context a context to generate in, it must belong to calling thread unless it is the only worker
+     * @param direct a module that takes generated functions without cache, nullptr writes them as bitcode piece
+     * @return bitcode pieces of generated functions or std::nullopt if any function failed to compile
+     */
+    [[nodiscard]] auto compile_functions(ast::function_list&, const std::vector<std::size_t>&, std::atomic<std::size_t>&, ast::arena&, const std::vector<std::string>&, llvm::LLVMContext& context, std::unique_ptr<llvm::Module>* direct) -> std::optional<pieces>;
+    [[nodiscard]] auto link(const ast::function_list&, std::vector<std::optional<pieces>>&, std::vector<std::unique_ptr<llvm::MemoryBuffer>>&, llvm::LLVMContext&) -> std::unique_ptr<llvm::Module>;
+    static auto restore_order(const ast::function_list&, llvm::Module&) -> void;
+};
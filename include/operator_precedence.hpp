@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "interner.hpp"
+#include "tables.hpp"
+
+/**
+ * Precedence of binary operators frozen after setup.
+ * Operators are registered in operator_table, which is then compiled into perfect hash over ids of their symbols,
+ * so lookup is one multiplication, one shift and one comparison, it never inserts and never grows.
+ * Table is immutable, so one instance may be shared by any number of parsers, also from several threads at once
+ */
+class operator_precedence {
+private:
+    /**
+     * Slot of hash table, empty slot holds default precedence so that a miss needs no separate check
+     */
+    struct slot {
+	symbol op{};                              ///< operator in slot
+	uint8_t precedence{default_precedence};   ///< precedence of operator
+    };
+
+    std::vector<slot> _slots;   ///< slots indexed by hash of symbol, size is power of two
+    uint32_t _multiplier;       ///< multiplier of hash, chosen so that registered operators do not collide
+    unsigned _shift;            ///< shift of hash, 32 - log2 of number of slots
+
+public:
+    static constexpr uint8_t default_precedence = 1; ///< precedence of identifier that is not an operator
+
+    /**
+     * Compile table of registered operators
+     * @param operators a precedence of every operator
+     */
+    explicit operator_precedence(const operator_table& operators);
+
+    operator_precedence()                                              = delete;
+    operator_precedence(const operator_precedence&)                    = default;
+    operator_precedence(operator_precedence&&)                         = default;
+    auto operator=(const operator_precedence&) -> operator_precedence& = delete;
+    auto operator=(operator_precedence&&)      -> operator_precedence& = delete;
+    ~operator_precedence()                                             = default;
+
+    /**
+     * Get precedence of symbol
+     * @return precedence of operator or default_precedence if symbol is not an operator
+     */
+    [[nodiscard]] auto operator[](symbol op) const noexcept -> uint8_t {
+	const auto& s = _slots[index(op, _multiplier, _shift)];
+	return s.op == op ? s.precedence : default_precedence;
+    }
+
+private:
+    [[nodiscard]] static auto index(symbol op, uint32_t multiplier, unsigned shift) noexcept -> uint32_t {
+	return (static_cast<uint32_t>(op) * multiplier) >> shift;
+    }
+};
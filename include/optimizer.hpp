@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include <llvm/IR/Function.h>
+#include <llvm/IR/Module.h>
+#include <llvm/IR/PassManager.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/CodeGen.h>
+
+/**
+ * Level of optimization, same meaning as -O of clang
+ */
+enum class opt_level : uint8_t {
+    O0, ///< no optimization, IR is emitted as generated
+    O1, ///< fast optimizations that do not increase size of code
+    O2, ///< most optimizations
+    O3, ///< all optimizations, including those that trade size for speed
+};
+
+/**
+ * Optimization settings of compilation
+ */
+struct optimization {
+    opt_level level{opt_level::O0};    ///< level of module pipeline that runs after functions are linked
+    bool per_function{false};          ///< run fast function pipeline on every function right after it is generated
+
+    /**
+     * Get canonical text of settings, it is a part of keys of cached modules and functions
+     */
+    [[nodiscard]] auto configuration() const -> std::string;
+};
+
+/**
+ * Get optimization level of machine code generator that matches level of IR optimization
+ */
+[[nodiscard]] auto codegen_level(opt_level level) -> llvm::CodeGenOpt::Level;
+
+/**
+ * Optimizer of LLVM IR built on new pass manager.
+ * Optimizer owns analysis managers, so one optimizer is used by one thread at a time.
+ * Analyses are dropped after every run, so IR that was optimized may be freed afterwards
+ */
+class optimizer {
+private:
+    llvm::LoopAnalysisManager _loop_analyses{};          ///< analyses of loops
+    llvm::FunctionAnalysisManager _function_analyses{};  ///< analyses of functions
+    llvm::CGSCCAnalysisManager _cgscc_analyses{};        ///< analyses of strongly connected components of call graph
+    llvm::ModuleAnalysisManager _module_analyses{};      ///< analyses of modules
+    llvm::PassBuilder _builder{};                        ///< builder of pipelines, registers all analyses
+    llvm::FunctionPassManager _function_pipeline{};      ///< fast function simplification pipeline, built once
+
+public:
+    optimizer();
+
+    optimizer(const optimizer&)            = delete;
+    optimizer(optimizer&&)                 = delete;
+    auto operator=(const optimizer&)       = delete;
+    auto operator=(optimizer&&)            = delete;
+    ~optimizer()                           = default;
+
+    /**
+     * Run fast function pipeline, simplification passes of -O1 that need no other function
+     * @param function a function to optimize, it may be run while other functions of its module are generated
+     */
+    auto run(llvm::Function& function) -> void;
+
+    /**
+     * Run default module pipeline of level, does nothing for opt_level::O0
+     * @param module a module to optimize
+     * @param level an optimization level
+     */
+    auto run(llvm::Module& module, opt_level level) -> void;
+
+private:
+    auto clear() -> void;
+};
@@ -1,19 +1,26 @@
 #pragma once
 
 #include <memory>
+#include <optional>
+#include <vector>
 
 #include "ast.hpp"
 #include "lexer.hpp"
+#include "operator_precedence.hpp"
 #include "tables.hpp"
 #include "scope.hpp"
+#include "token_stream.hpp"
 
 class parser {
 private:
-    lexer _lexer;
-    operator_table _table;
+    token_stream _tokens; ///< tokens of source, lexed ahead of parser
+    const operator_precedence& _table; ///< precedence of binary operators, shared with other parsers
+    ast::arena& _arena;
+    std::vector<symbol> _callees; ///< functions called from function that is being parsed
 
 public:
-    parser(lexer&&, operator_table&&);
+    parser(lexer&&, const operator_precedence&, ast::arena&);
+    parser(lexer&&, operator_precedence&&, ast::arena&) = delete;
 
     parser()                      = delete;
     parser(const parser&)         = delete;
@@ -22,12 +29,14 @@ public:
     auto operator=(parser&&)      = delete;
     ~parser()                     = default;
 
-    [[nodiscard]] auto parse_literal()                                               -> std::unique_ptr<ast::expression>;
-    [[nodiscard]] auto parse_parenthesis()                                           -> std::unique_ptr<ast::expression>;
-    [[nodiscard]] auto parse_indentifier()                                           -> std::unique_ptr<ast::expression>;
-    [[nodiscard]] auto parse_primary()                                               -> std::unique_ptr<ast::expression>;
-    [[nodiscard]] auto parse_expression()                                            -> std::unique_ptr<ast::expression>;
-    [[nodiscard]] auto parse_binary_rhs(uint8_t, std::unique_ptr<ast::expression>&&) -> std::unique_ptr<ast::expression>;
-    [[nodiscard]] auto parse_function()                                              -> std::unique_ptr<ast::function_expression>;
-    [[nodiscard]] auto parse_block()                                                 -> std::unique_ptr<ast::block_expression>;
+    [[nodiscard]] auto parse_literal()                             -> ast::expression*;
+    [[nodiscard]] auto parse_parenthesis()                         -> ast::expression*;
+    [[nodiscard]] auto parse_indentifier()                         -> ast::expression*;
+    [[nodiscard]] auto parse_primary()                             -> ast::expression*;
+    [[nodiscard]] auto parse_expression()                          -> ast::expression*;
+    [[nodiscard]] auto parse_binary_rhs(uint8_t, ast::expression*) -> ast::expression*;
+    [[nodiscard]] auto parse_function()                            -> ast::function_expression*;
+    [[nodiscard]] auto parse_block()                               -> ast::block_expression*;
+    [[nodiscard]] auto parse_module()                              -> std::optional<ast::function_list>;
+    [[nodiscard]] auto token_count() const noexcept                -> std::size_t;
 };
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Instruction set used to scan runs of characters
+ */
+enum class scan_mode : uint8_t {
+    scalar, ///< one character at a time through char_classes table
+    sse2,   ///< 16 characters at a time
+    avx2,   ///< 32 characters at a time
+};
+
+/**
+ * Set of routines that skip over runs of characters of one class.
+ * Every routine gets range [begin, end) and returns pointer to
+ * the first character that ends the run, or end if there is no such character
+ */
+struct scanner {
+    using scan_function = auto (*)(const char* begin, const char* end) noexcept -> const char*;
+
+    scan_function skip_identifier; ///< skip [a-zA-Z0-9_]
+    scan_function skip_blanks;     ///< skip ' ', '\t', '\v', '\f'
+    scan_function skip_digits;     ///< skip [0-9_]
+    scan_function find_eol;        ///< stop at '\n' or '\r'
+    scan_function find_star;       ///< stop at '*'
+
+    /**
+     * Get routines implemented with given instruction set
+     */
+    [[nodiscard]] static auto get(scan_mode) noexcept -> const scanner&;
+
+    /**
+     * Get routines selected for new lexers
+     */
+    [[nodiscard]] static auto active() noexcept -> const scanner&;
+
+    /**
+     * Select routines for new lexers, unsupported instruction sets fall back to the best supported one
+     * @param mode a requested instruction set
+     * @return instruction set that was actually selected
+     */
+    static auto select(scan_mode mode) noexcept -> scan_mode;
+
+    /**
+     * Get the widest instruction set supported by current CPU
+     */
+    [[nodiscard]] static auto best_mode() noexcept -> scan_mode;
+};
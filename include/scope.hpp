@@ -2,6 +2,7 @@
 
 #include <forward_list>
 
+#include "interner.hpp"
 #include "tables.hpp"
 #include "types.hpp"
 
@@ -11,11 +12,11 @@ private:
     function_symbol_table _functions{};
 
 public:
-    auto new_symbol(const std::string&, types::type*) -> void;
-    auto new_function(const std::string&, types::function_type*) -> void;
+    auto new_symbol(symbol, types::type*) -> void;
+    auto new_function(symbol, types::function_type*) -> void;
 
-    [[nodiscard]] auto search_symbol(const std::string&) -> types::type*;
-    [[nodiscard]] auto search_function(const std::string&) -> types::function_type*;
+    [[nodiscard]] auto search_symbol(symbol) -> types::type*;
+    [[nodiscard]] auto search_function(symbol) -> types::function_type*;
 
     scope()                      = default;
     scope(const scope&)          = delete;
@@ -40,9 +41,9 @@ public:
     auto new_scope() -> scope&;
     auto delete_scope() -> void;
 
-    auto new_symbol(const std::string&, types::type*) -> void;
-    auto new_function(const std::string&, types::function_type*) -> void;
+    auto new_symbol(symbol, types::type*) -> void;
+    auto new_function(symbol, types::function_type*) -> void;
 
-    [[nodiscard]] auto search_symbol(const std::string&) -> types::type*;
-    [[nodiscard]] auto search_function(const std::string&) -> types::function_type*;
+    [[nodiscard]] auto search_symbol(symbol) -> types::type*;
+    [[nodiscard]] auto search_function(symbol) -> types::function_type*;
 };
@@ -1,20 +1,31 @@
 #pragma once
 
+#include "ast/arena.hpp"
 #include "ast/visitor.hpp"
 #include "scope.hpp"
 
 class semantic_analyzer : public ast::type_visitor {
 private:
     scope_manager _sm;
+    ast::arena& _arena;
 
 public:
-    semantic_analyzer()                         = default;
+    semantic_analyzer(ast::arena&);
+
+    semantic_analyzer()                         = delete;
     semantic_analyzer(const semantic_analyzer&) = delete;
     semantic_analyzer(semantic_analyzer&&)      = delete;
     auto operator=(const semantic_analyzer&)    = delete;
     auto operator=(semantic_analyzer&&)         = delete;
     ~semantic_analyzer()                        = default;
-    
+
+    /**
+     * Make function defined elsewhere visible to calls in analysed functions
+     * @param name a name of a function
+     * @param type a type of a function
+     */
+    auto declare_function(symbol name, types::function_type* type) -> void;
+
     virtual auto visit(ast::expression*)                   -> types::type* override;
     virtual auto visit(ast::integer_literal_expression*)   -> types::type* override;
     virtual auto visit(ast::floating_literal_expression*)  -> types::type* override;
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <memory>
+#include <string_view>
+
+#include <llvm/Support/MemoryBuffer.h>
+
+/**
+ * Whole source file held in one contiguous, null-terminated buffer.
+ * Regular files are memory-mapped when they are large enough,
+ * piped input is read into a single heap buffer
+ */
+class source_buffer {
+private:
+    std::unique_ptr<llvm::MemoryBuffer> _buffer; ///< underlying storage of source text
+
+public:
+    /**
+     * Constructor of source buffer with file to read
+     * @param filename a name of a file to read, "-" reads standard input
+     */
+    source_buffer(std::string_view filename);
+
+    /**
+     * Constructor of source buffer that reads standard input until EOF
+     */
+    source_buffer();
+
+    /**
+     * Constructor of source buffer with already loaded text
+     * @param buffer a null-terminated buffer with source text
+     */
+    source_buffer(std::unique_ptr<llvm::MemoryBuffer> buffer);
+
+    source_buffer(const source_buffer&)                    = delete;
+    source_buffer(source_buffer&&)                         = default;
+    auto operator=(const source_buffer&)                   = delete;
+    auto operator=(source_buffer&&) -> source_buffer&      = default;
+    ~source_buffer()                                       = default;
+
+    /**
+     * Get pointer to the first character of the source
+     */
+    [[nodiscard]] auto begin() const noexcept -> const char*;
+
+    /**
+     * Get pointer past the last character of the source, always points to '\0'
+     */
+    [[nodiscard]] auto end()   const noexcept -> const char*;
+
+    /**
+     * Get size of the source in bytes
+     */
+    [[nodiscard]] auto size()  const noexcept -> std::size_t;
+
+    /**
+     * Get whole source text
+     */
+    [[nodiscard]] auto text()  const noexcept -> std::string_view;
+
+    /**
+     * Get name of the source i.e. file name or "<stdin>"
+     */
+    [[nodiscard]] auto name()  const noexcept -> std::string_view;
+};
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <llvm/Support/raw_ostream.h>
+
+/**
+ * Per-phase timing and counters of compilation, printed with -time-report.
+ * Phases are measured with scoped timers and summed over all threads, so with
+ * several workers the sum of phases may exceed wall time of compilation.
+ * Nothing is measured until collection is enabled
+ */
+namespace time_report {
+
+    /**
+     * Stage of compiler pipeline
+     */
+    enum class phase : uint8_t {
+	parse,   ///< lexing and parsing, lexer is driven by parser so they are measured together
+	sema,    ///< collection of signatures and semantic analysis
+	codegen, ///< generation of IR, including verification
+	verify,  ///< verification of generated functions
+	link,    ///< linking of modules generated by workers
+	optimize,///< optimization of functions and modules, function pipeline also counts as codegen
+	emit,    ///< printing or writing of modules
+    };
+
+    inline constexpr std::size_t phase_count = 7;
+
+    /**
+     * Quantity counted over all compiled files
+     */
+    enum class counter : uint8_t {
+	files,        ///< compiled input files
+	functions,    ///< parsed functions
+	tokens,       ///< tokens read by lexer
+	ast_nodes,    ///< nodes allocated in AST arenas
+	ast_bytes,    ///< bytes of nodes allocated in AST arenas
+	instructions, ///< IR instructions in compiled modules
+	cache_hits,   ///< files loaded from compilation cache instead of being compiled
+    };
+
+    inline constexpr std::size_t counter_count = 7;
+
+    /**
+     * Format of printed report
+     */
+    enum class format {
+	table, ///< human readable table
+	json,  ///< one JSON object
+    };
+
+    inline std::atomic<bool> collecting{false};                                  ///< true if phases and counters are collected
+    inline std::array<std::atomic<uint64_t>, phase_count> nanoseconds{};       ///< time spent in every phase
+    inline std::array<std::atomic<uint64_t>, counter_count> counters{};        ///< value of every counter
+
+    /**
+     * Start collection of phases and counters
+     */
+    inline auto enable() noexcept -> void {
+	collecting.store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * Check if phases and counters are collected
+     */
+    [[nodiscard]] inline auto enabled() noexcept -> bool {
+	return collecting.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Add value to counter, does nothing if collection is not enabled
+     */
+    inline auto count(counter c, uint64_t value) noexcept -> void {
+	if(enabled())
+	    counters[static_cast<std::size_t>(c)].fetch_add(value, std::memory_order_relaxed);
+    }
+
+    /**
+     * Timer that adds time of its scope to phase
+     */
+    class scope {
+    private:
+	using clock = std::chrono::steady_clock;
+
+	phase _phase;              ///< measured phase
+	bool _enabled{enabled()};  ///< collection was enabled when scope was entered
+	clock::time_point _start{_enabled ? clock::now() : clock::time_point{}}; ///< time when scope was entered
+
+    public:
+	/**
+	 * Constructor of timer
+	 * @param p a phase that is measured until timer is destroyed
+	 */
+	scope(phase p) noexcept
+	    : _phase{p}
+	{}
+
+	scope()                      = delete;
+	scope(const scope&)          = delete;
+	scope(scope&&)               = delete;
+	auto operator=(const scope&) = delete;
+	auto operator=(scope&&)      = delete;
+
+	~scope() {
+	    if(!_enabled)
+		return;
+	    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - _start);
+	    nanoseconds[static_cast<std::size_t>(_phase)].fetch_add(elapsed.count(), std::memory_order_relaxed);
+	}
+    };
+
+    /**
+     * Print collected phases, counters and peak resident set size
+     * @param out a stream to print to
+     * @param f a format of report
+     * @param wall_nanoseconds a wall time of whole compilation
+     */
+    auto print(llvm::raw_ostream& out, format f, uint64_t wall_nanoseconds) -> void;
+
+}
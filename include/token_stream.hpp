@@ -0,0 +1,141 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "interner.hpp"
+#include "lexer.hpp"
+
+/**
+ * Token read by lexer, as it is kept in token stream
+ */
+struct token_record {
+    tokens kind{};      ///< kind of token
+    source_span span{}; ///< location of token text in source buffer
+    symbol interned{};  ///< interned identifier, empty symbol if token is not an identifier
+};
+
+/**
+ * Stream of tokens with lookahead of several tokens.
+ * Tokens are kept in bounded single-producer single-consumer ring buffer. For large sources lexer runs
+ * on its own thread and fills the buffer ahead of parser, so lexing and parsing overlap.
+ * The largest sources are instead split into chunks that are lexed in parallel before parsing starts, see chunk_lexer.
+ * Small sources, and all sources on machines with one core, are lexed on demand on the thread of parser,
+ * starting a thread costs more than lexing them
+ */
+class token_stream {
+public:
+    /**
+     * Way tokens are produced
+     */
+    enum class strategy : uint8_t {
+	automatic, ///< chosen by size of source and number of cores
+	on_demand, ///< lexed on thread of parser when they are needed
+	pipelined, ///< lexed ahead of parser on producer thread
+	parallel,  ///< lexed in chunks on several threads before parsing
+    };
+
+    static constexpr uint32_t capacity = 1024;                      ///< number of tokens in ring buffer, power of two
+    static constexpr std::size_t pipeline_threshold = 256 * 1024;   ///< size of source from which lexer gets its own thread
+    static constexpr uint32_t batch = 32;                           ///< number of tokens pushed or consumed between wake-ups of other side
+
+private:
+    lexer _lexer;                                      ///< producer of tokens, owned by producer thread while it runs
+    std::array<token_record, capacity> _ring{};        ///< tokens pushed and not yet consumed
+    alignas(64) std::atomic<uint32_t> _head{0};        ///< number of tokens pushed, written by producer
+    alignas(64) std::atomic<uint32_t> _tail{0};        ///< number of tokens consumed, written by consumer
+    std::atomic<bool> _stopped{false};                 ///< consumer is destroyed, producer must stop
+    alignas(64) uint32_t _position{0};                 ///< consumer copy of _tail
+    uint32_t _available{0};                            ///< consumer copy of _head, refreshed when it runs out of tokens
+    bool _finished{false};                             ///< eof was pushed, nothing more will come
+    std::size_t _consumed{0};                          ///< number of tokens consumed
+    uint64_t _fingerprint{};                           ///< hash of tokens consumed since last reset
+    std::thread _producer{};                           ///< thread that runs lexer, not started for small sources
+    std::vector<token_record> _lexed{};                ///< all tokens of source lexed in parallel, ring is not used then
+
+public:
+    /**
+     * Constructor of token stream
+     * @param source_lexer a lexer that produces tokens
+     * @param how a way tokens are produced
+     */
+    token_stream(lexer&& source_lexer, strategy how = strategy::automatic);
+
+    token_stream()                              = delete;
+    token_stream(const token_stream&)           = delete;
+    token_stream(token_stream&&)                = delete;
+    auto operator=(const token_stream&)         = delete;
+    auto operator=(token_stream&&)              = delete;
+    ~token_stream();
+
+    /**
+     * Get token ahead of current one without consuming anything
+     * @param n a distance from current token, 0 is current token, must be less than capacity
+     * @return token, or eof if source ends before it
+     */
+    [[nodiscard]] auto peek(uint32_t n) noexcept -> const token_record&;
+
+    /**
+     * Get kind of current token
+     */
+    [[nodiscard]] auto token() noexcept -> tokens;
+
+    /**
+     * Get text of current token
+     * @return view into the source buffer, valid as long as stream is alive
+     */
+    [[nodiscard]] auto identifier() noexcept -> std::string_view;
+
+    /**
+     * Get current identifier as interned symbol
+     * @return symbol of identifier, empty symbol if token is not an identifier
+     */
+    [[nodiscard]] auto interned() noexcept -> symbol;
+
+    /**
+     * Get text of the source at given location
+     */
+    [[nodiscard]] auto text(source_span span) const noexcept -> std::string_view;
+
+    /**
+     * Move to next token, eof is never left
+     */
+    auto consume() noexcept -> void;
+
+    /**
+     * Get number of tokens consumed so far
+     */
+    [[nodiscard]] auto token_count() const noexcept -> std::size_t;
+
+    /**
+     * Get hash of kinds and text of tokens consumed since last reset,
+     * it does not depend on spaces and comments between tokens and is stable across runs
+     */
+    [[nodiscard]] auto fingerprint() const noexcept -> uint64_t;
+
+    /**
+     * Start new fingerprint, current token will be the first one hashed when it is consumed
+     */
+    auto reset_fingerprint() noexcept -> void;
+
+private:
+    /**
+     * Take current token of lexer and read the next one
+     */
+    [[nodiscard]] auto read() noexcept -> token_record;
+
+    /**
+     * Body of producer thread, pushes tokens until eof or until consumer stops it
+     */
+    auto produce() noexcept -> void;
+
+    /**
+     * Make at least n + 1 tokens available to consumer, unless eof comes before
+     */
+    auto fill(uint32_t n) noexcept -> void;
+};
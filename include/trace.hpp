@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Diagnostic tracing of compiler stages.
+ * Trace points are written with TRACE(category, level, format, args...) and
+ * compile to nothing unless COMPILER_TRACE is defined, so release builds pay nothing.
+ * When compiled in, every category is silent until enabled at runtime
+ */
+namespace trace {
+
+    /**
+     * Stage of compiler that emits trace
+     */
+    enum class category : uint8_t {
+	lexer,
+	parser,
+	sema,
+	codegen,
+	driver,
+    };
+
+    inline constexpr std::size_t category_count = 5;
+
+    /**
+     * Verbosity of trace, every level includes levels below it
+     */
+    enum class level : uint8_t {
+	off,   ///< nothing is printed
+	info,  ///< milestones of compilation e.g. module parsed
+	debug, ///< every token and AST node
+    };
+
+    inline std::array<std::atomic<level>, category_count> levels{}; ///< enabled level of every category
+
+    /**
+     * Check if trace of category at level should be printed
+     */
+    [[nodiscard]] inline auto enabled(category c, level l) noexcept -> bool {
+	return levels[static_cast<std::size_t>(c)].load(std::memory_order_relaxed) >= l;
+    }
+
+    /**
+     * Enable trace of category up to level
+     */
+    inline auto enable(category c, level l) noexcept -> void {
+	levels[static_cast<std::size_t>(c)].store(l, std::memory_order_relaxed);
+    }
+
+    /**
+     * Print one line of trace prefixed with name of category
+     */
+    [[gnu::format(printf, 2, 3)]] auto print(category c, const char* format, ...) -> void;
+
+}
+
+#ifdef COMPILER_TRACE
+#define TRACE(stage, verbosity, ...) \
+    do { \
+	if(::trace::enabled(::trace::category::stage, ::trace::level::verbosity)) \
+	    ::trace::print(::trace::category::stage, __VA_ARGS__); \
+    } while(false)
+#else
+#define TRACE(stage, verbosity, ...) do {} while(false)
+#endif
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace types {
+
+    /**
+     * Dense ids of builtin types, used to index dispatch tables of casts and operations
+     */
+    enum class builtin : uint8_t {
+	void_type,
+	boolean,
+	byte,
+	int8,
+	int16,
+	int32,
+	int64,
+	int128,
+	uint8,
+	uint16,
+	uint32,
+	uint64,
+	uint128,
+	float32,
+	float64,
+	character,
+	string,
+	none, ///< not a builtin type e.g. function type
+    };
+
+    inline constexpr std::size_t builtin_count = static_cast<std::size_t>(builtin::none); ///< number of builtin types
+
+    /**
+     * Spelling of every builtin type in source code, void type has no spelling
+     */
+    inline constexpr std::array<std::string_view, builtin_count> builtin_spellings = {
+	"", "bool", "byte",
+	"int8", "int16", "int32", "int64", "int128",
+	"uint8", "uint16", "uint32", "uint64", "uint128",
+	"float", "double", "char", "string",
+    };
+
+    /**
+     * Get index of builtin type in dispatch tables
+     */
+    [[nodiscard]] constexpr auto index(builtin id) noexcept -> std::size_t {
+	return static_cast<std::size_t>(id);
+    }
+
+}
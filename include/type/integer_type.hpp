@@ -8,7 +8,7 @@ namespace types {
 
     class integer_type : public type {
     public:
-	integer_type(llvm::IntegerType*, std::string&&);
+	integer_type(llvm::IntegerType*, std::string&&, builtin = builtin::none);
 
 	virtual ~integer_type() = default;
 
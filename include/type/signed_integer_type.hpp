@@ -6,7 +6,7 @@ namespace types {
 
     class signed_integer_type : public integer_type {
     public:
-	signed_integer_type(llvm::IntegerType*, std::string&&);
+	signed_integer_type(llvm::IntegerType*, std::string&&, builtin = builtin::none);
 
 	signed_integer_type()                                              = delete;
 	signed_integer_type(const signed_integer_type&)                    = default;
@@ -1,16 +1,20 @@
 #pragma once
 
+#include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Type.h>
 
+#include "builtin.hpp"
+
 namespace types {
 
     class type {
     private:
 	llvm::Type* _type{};
 	std::string _name{};
+	builtin _id{builtin::none};
 
     public:
-	type(llvm::Type*, std::string&&);
+	type(llvm::Type*, std::string&&, builtin = builtin::none);
 	
 	type()                               = default;
 	type(const type&)                    = default;
@@ -24,8 +28,21 @@ namespace types {
 	explicit operator bool() const noexcept;
 
 	[[nodiscard]] auto get() const noexcept -> llvm::Type*;
+
+	/**
+	 * Get the same LLVM type in another context, so that IR can be generated outside of global context
+	 * @param context a context to get type in
+	 * @return equivalent type owned by context
+	 */
+	[[nodiscard]] auto get(llvm::LLVMContext& context) const -> llvm::Type*;
 	[[nodiscard]] auto name() const noexcept -> const std::string&;
 
+	/**
+	 * Accessor of builtin id
+	 * @return id of builtin type or builtin::none for other types
+	 */
+	[[nodiscard]] auto id() const noexcept -> builtin;
+
 	[[nodiscard]] virtual auto is_signed() const noexcept -> bool;
 	[[nodiscard]] auto is_integral()       const noexcept -> bool;
 	[[nodiscard]] auto is_floating_point() const noexcept -> bool;
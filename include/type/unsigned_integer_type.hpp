@@ -6,7 +6,7 @@ namespace types {
 
     class unsigned_integer_type : public integer_type {
     public:
-	unsigned_integer_type(llvm::IntegerType*, std::string&&);
+	unsigned_integer_type(llvm::IntegerType*, std::string&&, builtin = builtin::none);
 
 	unsigned_integer_type()                                                = delete;
 	unsigned_integer_type(const unsigned_integer_type&)                    = default;
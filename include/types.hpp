@@ -1,5 +1,6 @@
 #pragma once
 
+#include "type/builtin.hpp"
 #include "type/type.hpp"
 #include "type/function_type.hpp"
 #include "type/integer_type.hpp"
@@ -0,0 +1,17 @@
+#include "ast/arena.hpp"
+
+ast::arena::arena(std::size_t initial_size)
+    : _resource{initial_size}
+{}
+
+[[nodiscard]] auto ast::arena::resource() noexcept -> std::pmr::memory_resource* {
+    return &_resource;
+}
+
+[[nodiscard]] auto ast::arena::node_count() const noexcept -> std::size_t {
+    return _nodes;
+}
+
+[[nodiscard]] auto ast::arena::node_bytes() const noexcept -> std::size_t {
+    return _bytes;
+}
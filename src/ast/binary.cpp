@@ -1,39 +1,40 @@
 #include "ast/binary.hpp"
 #include "ast/expression.hpp"
 #include "ast/visitor.hpp"
+#include "trace.hpp"
 
-ast::binary_expression::binary_expression(std::string&& op, std::unique_ptr<expression>&& lhs, std::unique_ptr<expression>&& rhs)
-    : _operator{std::move(op)}
-    , _lhs{std::move(lhs)}
-    , _rhs{std::move(rhs)}
+ast::binary_expression::binary_expression(symbol op, expression* lhs, expression* rhs)
+    : _operator{op}
+    , _lhs{lhs}
+    , _rhs{rhs}
 {}
 
 [[nodiscard]] auto ast::binary_expression::accept(value_visitor* v) const -> llvm::Value* {
-    fprintf(stderr, "binary accept value\n");
+    TRACE(codegen, debug, "binary accept value");
     return v->visit(this);
 }
 
 [[nodiscard]] auto ast::binary_expression::accept(type_visitor* v) -> types::type* {
-    fprintf(stderr, "binary accept type\n");
+    TRACE(sema, debug, "binary accept type");
     return v->visit(this);
 }
 
-[[nodiscard]] auto ast::binary_expression::op() const -> const std::string& {
+[[nodiscard]] auto ast::binary_expression::op() const -> symbol {
     return _operator;
 }
 
 [[nodiscard]] auto ast::binary_expression::lhs() const -> const ast::expression* {
-    return _lhs.get();
+    return _lhs;
 }
 
 [[nodiscard]] auto ast::binary_expression::rhs() const -> const ast::expression* {
-    return _rhs.get();
+    return _rhs;
 }
 
 [[nodiscard]] auto ast::binary_expression::lhs() -> ast::expression* {
-    return _lhs.get();
+    return _lhs;
 }
 
 [[nodiscard]] auto ast::binary_expression::rhs() -> ast::expression* {
-    return _rhs.get();
+    return _rhs;
 }
@@ -1,21 +1,22 @@
 #include "ast/block.hpp"
 #include "ast/visitor.hpp"
 #include "global_context.hpp"
+#include "trace.hpp"
 
-ast::block_expression::block_expression(std::vector<std::unique_ptr<ast::expression>>&& expressions)
+ast::block_expression::block_expression(expression_list&& expressions)
     : _expressions{std::move(expressions)}
 {}
 
 [[nodiscard]] auto ast::block_expression::accept(value_visitor* v) const -> llvm::Value* {
-    fprintf(stderr, "block accept value\n");
+    TRACE(codegen, debug, "block accept value");
     return v->visit(this);
 }
 
 [[nodiscard]] auto ast::block_expression::accept(type_visitor* v) -> types::type* {
-    fprintf(stderr, "block accept type\n");
+    TRACE(sema, debug, "block accept type");
     return v->visit(this);
 }
 
-[[nodiscard]] auto ast::block_expression::expressions() const -> const std::vector<std::unique_ptr<ast::expression>>& {
+[[nodiscard]] auto ast::block_expression::expressions() const -> const expression_list& {
     return _expressions;
 }
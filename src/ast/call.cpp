@@ -1,29 +1,30 @@
 #include "ast/call.hpp"
 #include "ast/visitor.hpp"
+#include "trace.hpp"
 
-ast::call_expression::call_expression(std::string&& callee, std::vector<std::unique_ptr<expression>>&& args)
-    : _callee{std::move(callee)}
+ast::call_expression::call_expression(symbol callee, expression_list&& args)
+    : _callee{callee}
     , _args{std::move(args)}
 {}
 
 [[nodiscard]] auto ast::call_expression::accept(value_visitor* v) const -> llvm::Value* {
-    fprintf(stderr, "call accept value\n");
+    TRACE(codegen, debug, "call accept value");
     return v->visit(this);
 }
 
 [[nodiscard]] auto ast::call_expression::accept(type_visitor* v) -> types::type* {
-    fprintf(stderr, "call accept type\n");
+    TRACE(sema, debug, "call accept type");
     return v->visit(this);
 }
 
-[[nodiscard]] auto ast::call_expression::callee() const -> const std::string& {
+[[nodiscard]] auto ast::call_expression::callee() const -> symbol {
     return _callee;
 }
 
-[[nodiscard]] auto ast::call_expression::args() const -> const std::vector<std::unique_ptr<expression>>& {
+[[nodiscard]] auto ast::call_expression::args() const -> const expression_list& {
     return _args;
 }
 
-[[nodiscard]] auto ast::call_expression::args() -> std::vector<std::unique_ptr<expression>>& {
+[[nodiscard]] auto ast::call_expression::args() -> expression_list& {
     return _args;
 }
@@ -1,18 +1,19 @@
 #include "ast/character_literal.hpp"
 #include "ast/visitor.hpp"
 #include "global_context.hpp"
+#include "trace.hpp"
 
-ast::character_literal_expression::character_literal_expression(std::string&& value)
+ast::character_literal_expression::character_literal_expression(std::string_view value)
     : _value{value[0]}
 {}
 
 [[nodiscard]] auto ast::character_literal_expression::accept(value_visitor* v) const -> llvm::Value* {
-    fprintf(stderr, "char accept value\n");
+    TRACE(codegen, debug, "char accept value");
     return v->visit(this);
 }
 
 [[nodiscard]] auto ast::character_literal_expression::accept(type_visitor* v) -> types::type* {
-    fprintf(stderr, "char accept type\n");
+    TRACE(sema, debug, "char accept type");
     return v->visit(this);
 }
 
@@ -1,18 +1,23 @@
+#include <charconv>
+
 #include "ast/floating_literal.hpp"
 #include "ast/visitor.hpp"
 #include "global_context.hpp"
+#include "trace.hpp"
 
-ast::floating_literal_expression::floating_literal_expression(std::string&& value)
-    : _value{std::stod(std::move(value))}
-{}
+ast::floating_literal_expression::floating_literal_expression(std::string_view value)
+    : _value{}
+{
+    std::from_chars(value.data(), value.data() + value.size(), _value);
+}
 
 [[nodiscard]] auto ast::floating_literal_expression::accept(value_visitor* v) const -> llvm::Value* {
-    fprintf(stderr, "float accept value\n");
+    TRACE(codegen, debug, "float accept value");
     return v->visit(this);
 }
 
 [[nodiscard]] auto ast::floating_literal_expression::accept(type_visitor* v) -> types::type* {
-    fprintf(stderr, "float accept type\n");
+    TRACE(sema, debug, "float accept type");
     return v->visit(this);
 }
 
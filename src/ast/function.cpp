@@ -1,45 +1,57 @@
 #include "ast/function.hpp"
 #include "ast/visitor.hpp"
+#include "trace.hpp"
 
-ast::function_expression::function_expression(std::string&& name, std::vector<std::string>&& args,
-	std::vector<std::string>&& type_list, std::string&& return_type, std::unique_ptr<block_expression>&& body)
-    : _name{std::move(name)}
+ast::function_expression::function_expression(symbol name, std::pmr::vector<symbol>&& args,
+	std::pmr::vector<symbol>&& type_list, symbol return_type, block_expression* body,
+	uint64_t fingerprint, std::pmr::vector<symbol>&& callees)
+    : _name{name}
     , _args{std::move(args)}
     , _types{std::move(type_list)}
-    , _ret_type{std::move(return_type)}
-    , _body{std::move(body)}
+    , _ret_type{return_type}
+    , _body{body}
+    , _fingerprint{fingerprint}
+    , _callees{std::move(callees)}
 {}
 
 [[nodiscard]] auto ast::function_expression::accept(value_visitor* v) const -> llvm::Value* {
-    fprintf(stderr, "function accept value\n");
+    TRACE(codegen, debug, "function accept value");
     return v->visit(this);
 }
 
 [[nodiscard]] auto ast::function_expression::accept(type_visitor* v) -> types::type* {
-    fprintf(stderr, "function accept type\n");
+    TRACE(sema, debug, "function accept type");
     return v->visit(this);
 }
 
-[[nodiscard]] auto ast::function_expression::name() const -> const std::string& {
+[[nodiscard]] auto ast::function_expression::name() const -> symbol {
     return _name;
 }
 
-[[nodiscard]] auto ast::function_expression::args() const -> const std::vector<std::string>& {
+[[nodiscard]] auto ast::function_expression::args() const -> const std::pmr::vector<symbol>& {
     return _args;
 }
 
-[[nodiscard]] auto ast::function_expression::types() const -> const std::vector<std::string>& {
+[[nodiscard]] auto ast::function_expression::types() const -> const std::pmr::vector<symbol>& {
     return _types;
 }
 
-[[nodiscard]] auto ast::function_expression::return_type() const -> const std::string& {
+[[nodiscard]] auto ast::function_expression::return_type() const -> symbol {
     return _ret_type;
 }
 
 [[nodiscard]] auto ast::function_expression::body() const -> const ast::block_expression* {
-    return _body.get();
+    return _body;
 }
 
 [[nodiscard]] auto ast::function_expression::body() -> ast::block_expression* {
-    return _body.get();
+    return _body;
+}
+
+[[nodiscard]] auto ast::function_expression::fingerprint() const -> uint64_t {
+    return _fingerprint;
+}
+
+[[nodiscard]] auto ast::function_expression::callees() const -> const std::pmr::vector<symbol>& {
+    return _callees;
 }
@@ -1,14 +1,15 @@
 #include "ast/implicit_cast.hpp"
 #include "ast/visitor.hpp"
+#include "trace.hpp"
 
-ast::implicit_cast::implicit_cast(std::unique_ptr<expression>&& subj, types::type* to)
-    : _subject{std::move(subj)}
+ast::implicit_cast::implicit_cast(expression* subj, types::type* to)
+    : _subject{subj}
 {
     type() = to;
 }
 
 [[nodiscard]] auto ast::implicit_cast::accept(ast::value_visitor* v) const -> llvm::Value* {
-    fprintf(stderr, "cast accept value\n");
+    TRACE(codegen, debug, "cast accept value");
     return v->visit(this);
 }
 
@@ -18,5 +19,5 @@ ast::implicit_cast::implicit_cast(std::unique_ptr<expression>&& subj, types::typ
 }
 
 [[nodiscard]] auto ast::implicit_cast::subject() const -> const expression* {
-    return _subject.get();
+    return _subject;
 }
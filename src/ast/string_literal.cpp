@@ -1,21 +1,22 @@
 #include "ast/string_literal.hpp"
 #include "ast/visitor.hpp"
 #include "global_context.hpp"
+#include "trace.hpp"
 
-ast::string_literal_expression::string_literal_expression(std::string&& value)
-    : _value{std::move(value)}
+ast::string_literal_expression::string_literal_expression(std::string_view value)
+    : _value{value}
 {}
 
 [[nodiscard]] auto ast::string_literal_expression::accept(value_visitor* v) const -> llvm::Value* {
-    fprintf(stderr, "string accept value\n");
+    TRACE(codegen, debug, "string accept value");
     return v->visit(this);
 }
 
 [[nodiscard]] auto ast::string_literal_expression::accept(type_visitor* v) -> types::type* {
-    fprintf(stderr, "string accept type\n");
+    TRACE(sema, debug, "string accept type");
     return v->visit(this);
 }
 
-[[nodiscard]] auto ast::string_literal_expression::value() const -> const std::string& {
+[[nodiscard]] auto ast::string_literal_expression::value() const -> std::string_view {
     return _value;
 }
@@ -1,21 +1,22 @@
 #include "ast/variable.hpp"
 #include "ast/visitor.hpp"
+#include "trace.hpp"
 
-ast::variable_expression::variable_expression(std::string&& name) 
-    : _name{std::move(name)} 
+ast::variable_expression::variable_expression(symbol name) 
+    : _name{name} 
 {}
 
 [[nodiscard]] auto ast::variable_expression::accept(value_visitor* v) const -> llvm::Value* {
-    fprintf(stderr, "var accept value\n");
+    TRACE(codegen, debug, "var accept value");
     return v->visit(this);
 }
 
 [[nodiscard]] auto ast::variable_expression::accept(type_visitor* v) -> types::type* {
-    fprintf(stderr, "var accept type\n");
+    TRACE(sema, debug, "var accept type");
     return v->visit(this);
 }
 
-[[nodiscard]] auto ast::variable_expression::name() const -> const std::string& {
+[[nodiscard]] auto ast::variable_expression::name() const -> symbol {
     return _name;
 }
 
@@ -0,0 +1,127 @@
+#include <algorithm>
+#include <optional>
+
+#include <llvm/Support/ThreadPool.h>
+
+#include "chunk_lexer.hpp"
+#include "trace.hpp"
+
+namespace {
+
+    /**
+     * Tokens of one chunk lexed speculatively
+     */
+    struct chunk {
+	std::size_t begin{};               ///< offset of the first character of chunk, beginning of a line
+	std::size_t end{};                 ///< offset past the last character of chunk
+	std::vector<token_record> tokens{}; ///< tokens that start reading before end
+	std::vector<std::size_t> ends{};    ///< position of lexer after every token, increasing
+    };
+
+    auto current(const lexer& l) -> token_record {
+	return {l.token(), l.span(), l.interned()};
+    }
+
+    /**
+     * Lex chunk as if it started outside of comments and string literals
+     */
+    auto lex_chunk(const lexer& source, chunk& c) -> void {
+	const bool last = c.end == source.size();
+	auto l = lexer{source, c.begin};
+	while(true) {
+	    c.tokens.push_back(current(l));
+	    c.ends.push_back(l.position());
+	    if(c.tokens.back().kind == tokens::eof || (!last && l.position() >= c.end))
+		return;
+	    l.consume();
+	}
+    }
+
+    /**
+     * Split source into chunks of about equal size that begin at beginnings of lines
+     */
+    auto split(const lexer& source, std::size_t count) -> std::vector<chunk> {
+	auto text = source.text(source_span{0, static_cast<uint32_t>(source.size())});
+	std::vector<chunk> chunks;
+	std::size_t begin = 0;
+	for(std::size_t i = 1; i <= count && begin < text.size(); ++i) {
+	    std::size_t end = text.size();
+	    if(i != count) {
+		auto newline = text.find('\n', std::max(begin, text.size() / count * i));
+		end = newline == std::string_view::npos ? text.size() : newline + 1;
+	    }
+	    chunks.push_back(chunk{begin, end});
+	    begin = end;
+	}
+	return chunks;
+    }
+
+}
+
+[[nodiscard]] auto chunk_lexer::lex(const lexer& source, unsigned threads) -> std::vector<token_record> {
+    auto strategy = llvm::hardware_concurrency(threads);
+    auto count = std::max<std::size_t>(1, std::min<std::size_t>(strategy.compute_thread_count(), source.size() / min_chunk));
+    auto chunks = split(source, count);
+    TRACE(lexer, info, "lexing %zu bytes in %zu chunks", source.size(), chunks.size());
+
+    if(chunks.size() == 1)
+	lex_chunk(source, chunks[0]);
+    else {
+	llvm::ThreadPool pool{llvm::hardware_concurrency(static_cast<unsigned>(chunks.size()))};
+	for(auto& c: chunks)
+	    pool.async([&source, &c] { lex_chunk(source, c); });
+	pool.wait();
+    }
+
+    // stitch chunks, resume is position of lexer that read all tokens so far
+    std::vector<token_record> result;
+    std::size_t total = 0;
+    for(const auto& c: chunks)
+	total += c.tokens.size();
+    result.reserve(total + 1);
+
+    std::size_t resume = 0;
+    for(const auto& c: chunks) {
+	if(!result.empty() && result.back().kind == tokens::eof)
+	    break;
+
+	// speculation holds from the first token boundary shared with the real lexer
+	auto synchronized = [&c] (std::size_t position) -> std::optional<std::size_t> {
+	    if(position == c.begin)
+		return 0;
+	    auto found = std::lower_bound(c.ends.begin(), c.ends.end(), position);
+	    if(found == c.ends.end() || *found != position)
+		return std::nullopt;
+	    return static_cast<std::size_t>(found - c.ends.begin()) + 1;
+	};
+
+	auto from = synchronized(resume);
+	if(!from && resume < c.ends.back()) {
+	    TRACE(lexer, info, "chunk at %zu starts inside of token, lexing again from %zu", c.begin, resume);
+	    auto l = lexer{source, resume};
+	    while(true) {
+		result.push_back(current(l));
+		resume = l.position();
+		if(result.back().kind == tokens::eof || (from = synchronized(resume)) || resume >= c.ends.back())
+		    break;
+		l.consume();
+	    }
+	}
+	if(!from)
+	    continue; // chunk is covered by tokens of previous chunks
+	result.insert(result.end(), c.tokens.begin() + static_cast<std::ptrdiff_t>(*from), c.tokens.end());
+	resume = c.ends.back();
+    }
+
+    // token of earlier chunk may run up to the end of source, e.g. unterminated string, eof is read after it
+    if(result.empty() || result.back().kind != tokens::eof) {
+	auto l = lexer{source, resume};
+	while(true) {
+	    result.push_back(current(l));
+	    if(result.back().kind == tokens::eof)
+		break;
+	    l.consume();
+	}
+    }
+    return result;
+}
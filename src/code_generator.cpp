@@ -15,28 +15,63 @@
 #include "code_generator.hpp"
 #include "global_context.hpp"
 #include "tables.hpp"
+#include "time_report.hpp"
+#include "trace.hpp"
 
-code_generator::code_generator(const std::string& module_name)
-    : _module{std::make_unique<llvm::Module>(module_name, global_context::context())}
-    , _builder{std::make_unique<llvm::IRBuilder<>>(global_context::context())}
+code_generator::code_generator(const std::string& module_name, optimizer* function_optimizer)
+    : code_generator{module_name, function_optimizer, global_context::context()}
 {}
 
+code_generator::code_generator(const std::string& module_name, optimizer* function_optimizer, llvm::LLVMContext& context)
+    : _context{context}
+    , _module{std::make_unique<llvm::Module>(module_name, _context)}
+    , _builder{std::make_unique<llvm::IRBuilder<>>(_context)}
+    , _optimizer{function_optimizer}
+{}
+
+auto code_generator::declare_function(symbol name, types::function_type* type) -> llvm::Function* {
+    auto func_type = static_cast<llvm::FunctionType*>(type->get(_context));
+    auto function = llvm::Function::Create(func_type, llvm::Function::ExternalLinkage, interner::spelling(name), _module.get());
+
+    // signedness of integers is kept in attributes, so that callers outside of language extend them correctly
+    auto extension = [] (const types::type* t) {
+	return t->is_boolean() || !t->is_signed() ? llvm::Attribute::ZExt : llvm::Attribute::SExt;
+    };
+    unsigned index = 0;
+    for(auto param: *type) {
+	if(param->is_integral())
+	    function->addParamAttr(index, extension(param));
+	++index;
+    }
+    if(type->get_return_type()->is_integral())
+	function->addRetAttr(extension(type->get_return_type()));
+    return function;
+}
+
+[[nodiscard]] auto code_generator::get_module() const -> const llvm::Module& {
+    return *_module;
+}
+
+[[nodiscard]] auto code_generator::release_module() -> std::unique_ptr<llvm::Module> {
+    return std::move(_module);
+}
+
 auto code_generator::visit(const ast::expression* expr) -> llvm::Value* {
     return expr->accept(this);
 }
 
 auto code_generator::visit(const ast::integer_literal_expression* expr) -> llvm::Value* {
-    fprintf(stderr, "%s - %d - %s", expr->value().data(), expr->radix(), expr->type()->name().data());
-    auto type = static_cast<llvm::IntegerType*>(expr->type()->get());
-    return llvm::ConstantInt::get(type, expr->value(), expr->radix());
+    TRACE(codegen, debug, "integer literal %.*s, radix %d, type %s", static_cast<int>(expr->text().size()), expr->text().data(), expr->radix(), expr->type()->name().data());
+    auto type = static_cast<llvm::IntegerType*>(expr->type()->get(_context));
+    return llvm::ConstantInt::get(type, llvm::APInt{type->getBitWidth(), expr->value().words});
 }
 
 auto code_generator::visit(const ast::floating_literal_expression* expr) -> llvm::Value* {
-    return llvm::ConstantFP::get(global_context::context(), llvm::APFloat(expr->value()));
+    return llvm::ConstantFP::get(_context, llvm::APFloat(expr->value()));
 }
 
 auto code_generator::visit(const ast::character_literal_expression* expr) -> llvm::Value* {
-    return llvm::ConstantInt::get(expr->type()->get(), expr->value());
+    return llvm::ConstantInt::get(expr->type()->get(_context), expr->value());
 }
 
 auto code_generator::visit(const ast::string_literal_expression* expr) -> llvm::Value* {
@@ -44,12 +79,12 @@ auto code_generator::visit(const ast::string_literal_expression* expr) -> llvm::
 }
 
 auto code_generator::visit(const ast::variable_expression* expr) -> llvm::Value* {
-    llvm::Value* v = _named_values[expr->name()];
-    if(!v) {
+    auto found = _named_values.find(expr->name());
+    if(found == _named_values.end()) {
 	fprintf(stderr, "error: unknown variable name");
 	return nullptr;
     }
-    return v;
+    return found->second;
 }
 
 auto code_generator::visit(const ast::binary_expression* expr) -> llvm::Value* {
@@ -62,7 +97,7 @@ auto code_generator::visit(const ast::binary_expression* expr) -> llvm::Value* {
 }
 
 auto code_generator::visit(const ast::call_expression* expr) -> llvm::Value* {
-    llvm::Function* callee = _module->getFunction(expr->callee());
+    llvm::Function* callee = _module->getFunction(interner::spelling(expr->callee()));
     if(!callee) {
 	fprintf(stderr, "error: unknown function reference");
 	return nullptr;
@@ -75,7 +110,7 @@ auto code_generator::visit(const ast::call_expression* expr) -> llvm::Value* {
 
     std::vector<llvm::Value*> arg_values;
     for(const auto& arg: expr->args()) {
-	arg_values.emplace_back(visit(arg.get()));
+	arg_values.emplace_back(visit(arg));
 	if(!arg_values.back())
 	    return nullptr;
     }
@@ -84,48 +119,64 @@ auto code_generator::visit(const ast::call_expression* expr) -> llvm::Value* {
 }
 
 auto code_generator::visit(const ast::function_expression* expr) -> llvm::Value* {
-    llvm::FunctionType* func_type = static_cast<llvm::FunctionType*>(expr->type()->get());
-    fprintf(stderr, "got function type\n");
-    // create function
-    llvm::Function* function = llvm::Function::Create(func_type, llvm::Function::ExternalLinkage, expr->name(), _module.get());
-    fprintf(stderr, "created function\n");
+    // define function that was declared beforehand or create a new one
+    llvm::Function* function = _module->getFunction(interner::spelling(expr->name()));
+    bool declared = function;
+    if(declared && !function->empty()) {
+	fprintf(stderr, "error: redefinition of function");
+	return nullptr;
+    }
+    if(!declared)
+	function = declare_function(expr->name(), static_cast<types::function_type*>(expr->type()));
+    TRACE(codegen, debug, "created function");
 
     // set arguments names, types and add fuction arguments to named values
     _named_values.clear();
     std::ranges::for_each(expr->args(), [this, farg = function->arg_begin()] (const auto& arg) mutable {
-	farg->setName(arg);
+	farg->setName(interner::spelling(arg));
 	_named_values[arg] = farg++;
     });
 
     // create basic block to write to
-    llvm::BasicBlock* block = llvm::BasicBlock::Create(global_context::context(), "entry", function);
+    llvm::BasicBlock* block = llvm::BasicBlock::Create(_context, "entry", function);
     _builder->SetInsertPoint(block);
 
     if(llvm::Value* return_value = visit(expr->body())) {
 	_builder->CreateRet(return_value);
 
-	llvm::verifyFunction(*function);
+	{
+	    auto timer = time_report::scope{time_report::phase::verify};
+	    llvm::verifyFunction(*function);
+	}
+	if(_optimizer) {
+	    auto timer = time_report::scope{time_report::phase::optimize};
+	    _optimizer->run(*function);
+	}
 
 	return function;
     }
 
-    function->eraseFromParent();
+    // keep declaration that other functions may refer to
+    if(declared)
+	function->deleteBody();
+    else
+	function->eraseFromParent();
     return nullptr;
 }
 
 auto code_generator::visit(const ast::block_expression* expr) -> llvm::Value* {
     if(expr->expressions().size() == 1)
-	return visit(expr->expressions().front().get());
+	return visit(expr->expressions().front());
 
     for(auto it = expr->expressions().begin(); it != expr->expressions().end() - 1; ++it) {
-	if(!visit(it->get()))
+	if(!visit(*it))
 	    return nullptr;
     }
-    return visit(expr->expressions().back().get());
+    return visit(expr->expressions().back());
 }
 
 auto code_generator::visit(const ast::implicit_cast* cast) -> llvm::Value* {
     llvm::Value* subject_value = cast->subject()->accept(this);
-    std::function<cast_function> cast_func = global_context::cast(cast->subject()->type(), cast->type());
+    auto cast_func = global_context::cast(cast->subject()->type(), cast->type());
     return cast_func(_builder.get(), subject_value);
 }
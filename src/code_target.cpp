@@ -0,0 +1,105 @@
+#include <cstdio>
+#include <mutex>
+
+#include <llvm/ADT/StringMap.h>
+#include <llvm/ADT/Triple.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/MC/SubtargetFeature.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/TargetSelect.h>
+
+#include "code_target.hpp"
+#include "trace.hpp"
+
+namespace {
+
+    /**
+     * Register all backends LLVM was built with, once per process
+     */
+    auto initialize_targets() -> void {
+	static std::once_flag initialized;
+	std::call_once(initialized, [] {
+	    llvm::InitializeAllTargetInfos();
+	    llvm::InitializeAllTargets();
+	    llvm::InitializeAllTargetMCs();
+	    llvm::InitializeAllAsmPrinters();
+	});
+    }
+
+    /**
+     * Get features of host CPU in form accepted by TargetMachine
+     */
+    auto host_features() -> std::string {
+	llvm::StringMap<bool> host;
+	llvm::SubtargetFeatures features;
+	if(llvm::sys::getHostCPUFeatures(host))
+	    for(const auto& feature: host)
+		features.AddFeature(feature.getKey(), feature.getValue());
+	return features.getString();
+    }
+
+}
+
+code_target::code_target(const llvm::Target* target, std::string triple, std::string cpu, std::string features, opt_level level, llvm::DataLayout layout)
+    : _target{target}
+    , _triple{std::move(triple)}
+    , _cpu{std::move(cpu)}
+    , _features{std::move(features)}
+    , _level{level}
+    , _layout{std::move(layout)}
+{}
+
+[[nodiscard]] auto code_target::create(std::string triple, std::string cpu, std::string features, opt_level level) -> std::unique_ptr<code_target> {
+    initialize_targets();
+
+    triple = llvm::Triple::normalize(triple.empty() ? llvm::sys::getDefaultTargetTriple() : triple);
+    std::string error;
+    const llvm::Target* target = llvm::TargetRegistry::lookupTarget(triple, error);
+    if(!target) {
+	fprintf(stderr, "error: unknown target \"%s\": %s\n", triple.c_str(), error.c_str());
+	return nullptr;
+    }
+
+    // explicit features are appended, so they override features of host
+    if(cpu == "native") {
+	cpu = llvm::sys::getHostCPUName().str();
+	auto host = host_features();
+	features = features.empty() ? host : host + ',' + features;
+    }
+
+    auto machine = std::unique_ptr<llvm::TargetMachine>{target->createTargetMachine(triple, cpu, features, llvm::TargetOptions{}, llvm::Reloc::PIC_, llvm::None, codegen_level(level))};
+    if(!machine) {
+	fprintf(stderr, "error: unable to create target machine for \"%s\"\n", triple.c_str());
+	return nullptr;
+    }
+    TRACE(driver, info, "target %s, cpu %s", triple.c_str(), cpu.empty() ? "generic" : cpu.c_str());
+    return std::unique_ptr<code_target>{new code_target{target, std::move(triple), std::move(cpu), std::move(features), level, machine->createDataLayout()}};
+}
+
+auto code_target::apply(llvm::Module& module) const -> void {
+    module.setTargetTriple(_triple);
+    module.setDataLayout(_layout);
+}
+
+[[nodiscard]] auto code_target::emit_object(llvm::Module& module, llvm::raw_pwrite_stream& out) const -> bool {
+    if(module.getTargetTriple() != _triple || module.getDataLayout() != _layout)
+	apply(module);
+
+    auto tm = machine();
+    llvm::legacy::PassManager passes; // code generator still runs on legacy pass manager
+    if(tm->addPassesToEmitFile(passes, out, nullptr, llvm::CGFT_ObjectFile)) {
+	fprintf(stderr, "error: target \"%s\" cannot emit object files\n", _triple.c_str());
+	return false;
+    }
+    passes.run(module);
+    return true;
+}
+
+[[nodiscard]] auto code_target::configuration() const -> std::string {
+    return _triple + ' ' + _cpu + ' ' + _features + '\n';
+}
+
+[[nodiscard]] auto code_target::machine() const -> std::unique_ptr<llvm::TargetMachine> {
+    // position independent code links into executables built as PIE by default
+    return std::unique_ptr<llvm::TargetMachine>{_target->createTargetMachine(_triple, _cpu, _features, llvm::TargetOptions{}, llvm::Reloc::PIC_, llvm::None, codegen_level(_level))};
+}
@@ -0,0 +1,184 @@
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Format.h>
+#include <llvm/Support/SHA256.h>
+
+#include "compilation_cache.hpp"
+#include "interner.hpp"
+#include "trace.hpp"
+
+#ifndef COMPILER_VERSION
+#define COMPILER_VERSION "unknown"
+#endif
+
+namespace {
+
+    constexpr std::string_view entry_extension = ".bc";
+    constexpr std::string_view compiler_version = "compiler_frontend " COMPILER_VERSION " entries 2 llvm " LLVM_VERSION_STRING; ///< entries revision changes with content of generated modules
+
+    /**
+     * Separate fields of key, so that e.g. name "ab" with source "c" differs from name "a" with source "bc"
+     */
+    auto update_field(llvm::SHA256& hash, std::string_view field) -> void {
+	uint64_t size = field.size();
+	hash.update(llvm::ArrayRef<uint8_t>{reinterpret_cast<const uint8_t*>(&size), sizeof(size)});
+	hash.update(llvm::StringRef{field.data(), field.size()});
+    }
+
+}
+
+compilation_cache::compilation_cache(std::string directory, uint64_t max_bytes)
+    : _directory{std::move(directory)}
+    , _max_bytes{max_bytes}
+{
+    std::error_code error;
+    std::filesystem::create_directories(_directory, error);
+    if(error)
+	fprintf(stderr, "error: unable to create cache directory \"%s\": %s\n", _directory.c_str(), error.message().c_str());
+    evict(); // takes initial size of directory
+}
+
+[[nodiscard]] auto compilation_cache::key(std::string_view source, std::string_view configuration, std::string_view module_name) -> std::string {
+    llvm::SHA256 hash;
+    update_field(hash, compiler_version);
+    update_field(hash, "module");
+    update_field(hash, configuration);
+    update_field(hash, module_name);
+    update_field(hash, source);
+    return llvm::toHex(hash.final(), /* LowerCase */ true);
+}
+
+[[nodiscard]] auto compilation_cache::configuration(const operator_table& operators, const optimization& opt) -> std::string {
+    // order of hash table depends on history of insertions, so operators are sorted by spelling
+    std::vector<std::pair<std::string_view, uint8_t>> precedences;
+    for(const auto& [op, precedence]: operators)
+	precedences.emplace_back(interner::spelling(op), precedence);
+    std::ranges::sort(precedences);
+
+    std::string table;
+    for(const auto& [spelling, precedence]: precedences) {
+	table += spelling;
+	table += ' ';
+	table += std::to_string(precedence);
+	table += '\n';
+    }
+    return table + opt.configuration();
+}
+
+[[nodiscard]] auto compilation_cache::function_key(std::string_view configuration, std::string_view function) -> std::string {
+    llvm::SHA256 hash;
+    update_field(hash, compiler_version);
+    update_field(hash, "function");
+    update_field(hash, configuration);
+    update_field(hash, function);
+    return llvm::toHex(hash.final(), /* LowerCase */ true);
+}
+
+[[nodiscard]] auto compilation_cache::lookup(const std::string& key) -> std::unique_ptr<llvm::MemoryBuffer> {
+    auto entry = path(key);
+    auto buffer = llvm::MemoryBuffer::getFile(entry, /* IsText */ false, /* RequiresNullTerminator */ false);
+    if(!buffer) {
+	++_misses;
+	return nullptr;
+    }
+
+    // modification time orders entries for eviction
+    std::error_code error;
+    std::filesystem::last_write_time(entry, std::filesystem::file_time_type::clock::now(), error);
+    ++_hits;
+    TRACE(driver, info, "cache hit %s", key.c_str());
+    return std::move(*buffer);
+}
+
+auto compilation_cache::store(const std::string& key, llvm::StringRef data) -> void {
+    auto temporary = llvm::sys::fs::TempFile::create(_directory + "/%%%%%%%%.tmp");
+    if(!temporary) {
+	llvm::consumeError(temporary.takeError());
+	return;
+    }
+
+    {
+	llvm::raw_fd_ostream stream{temporary->FD, /* shouldClose */ false};
+	stream << data;
+    }
+    if(auto error = temporary->keep(path(key))) {
+	llvm::consumeError(std::move(error));
+	return;
+    }
+    ++_stores;
+    TRACE(driver, info, "cache store %s", key.c_str());
+    // replaced entries are counted twice, estimate only errs towards scanning early
+    if(_estimated_bytes.fetch_add(data.size()) + data.size() > _max_bytes)
+	evict();
+}
+
+auto compilation_cache::remove(const std::string& key) -> void {
+    std::error_code error;
+    std::filesystem::remove(path(key), error);
+}
+
+auto compilation_cache::print_statistics(llvm::raw_ostream& out) const -> void {
+    uint64_t hits = _hits, misses = _misses;
+    double ratio = hits + misses ? 100.0 * static_cast<double>(hits) / static_cast<double>(hits + misses) : 0.0;
+    out << llvm::format("cache: %llu hits, %llu misses (%.1f%% hit rate), %llu stores, %llu evictions\n",
+	    static_cast<unsigned long long>(hits), static_cast<unsigned long long>(misses), ratio,
+	    static_cast<unsigned long long>(_stores.load()), static_cast<unsigned long long>(_evictions.load()));
+}
+
+[[nodiscard]] auto compilation_cache::path(const std::string& key) const -> std::string {
+    return _directory + '/' + key + std::string{entry_extension};
+}
+
+auto compilation_cache::evict() -> void {
+    struct entry {
+	std::filesystem::path path;
+	std::filesystem::file_time_type used;
+	uint64_t size;
+    };
+
+    std::lock_guard lock{_eviction_mutex};
+    std::vector<entry> entries;
+    uint64_t total = 0;
+    std::error_code error;
+    for(const auto& file: std::filesystem::directory_iterator{_directory, error}) {
+	if(file.path().extension() != entry_extension)
+	    continue;
+	std::error_code status;
+	auto size = file.file_size(status);
+	auto used = file.last_write_time(status);
+	if(status)
+	    continue; // removed by another process
+	entries.push_back({file.path(), used, size});
+	total += size;
+    }
+    if(total <= _max_bytes) {
+	_estimated_bytes = total;
+	return;
+    }
+
+    std::ranges::sort(entries, {}, &entry::used);
+    for(const auto& e: entries) {
+	if(total <= _max_bytes)
+	    break;
+	// entry that could not be removed still takes space, entry removed by another process does not
+	bool removed = std::filesystem::remove(e.path, error);
+	if(error) {
+	    fprintf(stderr, "error: unable to evict cache entry \"%s\": %s\n", e.path.c_str(), error.message().c_str());
+	    continue;
+	}
+	if(removed)
+	    ++_evictions;
+	total -= e.size;
+    }
+    _estimated_bytes = total;
+}
@@ -0,0 +1,305 @@
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/Support/Base64.h>
+#include <llvm/Support/JSON.h>
+#include <llvm/Support/ThreadPool.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include "compile_server.hpp"
+#include "trace.hpp"
+
+namespace {
+
+    auto write_all(int fd, std::string_view data) -> bool {
+	while(!data.empty()) {
+	    ssize_t written = ::write(fd, data.data(), data.size());
+	    if(written < 0 && errno == EINTR)
+		continue;
+	    if(written <= 0)
+		return false;
+	    data.remove_prefix(static_cast<std::size_t>(written));
+	}
+	return true;
+    }
+
+    auto is_blank(std::string_view line) -> bool {
+	return line.find_first_not_of(" \t\r") == std::string_view::npos;
+    }
+
+    auto respond(llvm::json::Object&& response) -> std::string {
+	std::string text;
+	llvm::raw_string_ostream stream{text};
+	stream << llvm::json::Value(std::move(response));
+	return stream.str();
+    }
+
+    auto error(llvm::json::Value id, std::string message) -> std::string {
+	return respond(llvm::json::Object{{"id", std::move(id)}, {"status", "error"}, {"error", std::move(message)}});
+    }
+
+    /**
+     * Client of listening server, its socket is closed when neither poll loop nor worker holds it
+     */
+    struct connection {
+	int fd;                              ///< socket of client
+	std::string pending{};               ///< bytes received after last complete request
+	std::mutex mutex{};                  ///< guards requests and busy
+	std::deque<std::string> requests{};  ///< complete requests that were not answered yet
+	bool busy{false};                    ///< a worker answers requests of connection
+
+	connection(int fd)
+	    : fd{fd}
+	{}
+
+	connection()                      = delete;
+	connection(const connection&)     = delete;
+	connection(connection&&)          = delete;
+	auto operator=(const connection&) = delete;
+	auto operator=(connection&&)      = delete;
+
+	~connection() {
+	    ::close(fd);
+	}
+    };
+
+}
+
+compile_server::compile_server(const frontend& compiler, const code_target* target)
+    : _frontend{compiler}
+    , _target{target}
+{}
+
+auto compile_server::serve(int input, int output) -> void {
+    std::string pending;
+    char chunk[4096];
+    bool open = true;
+    while(open && !_stopped) {
+	ssize_t count = ::read(input, chunk, sizeof(chunk));
+	if(count < 0 && errno == EINTR)
+	    continue;
+	if(count <= 0) {
+	    open = false;
+	    pending += '\n'; // answer last request even if it is not terminated
+	} else
+	    pending.append(chunk, static_cast<std::size_t>(count));
+
+	std::size_t begin = 0;
+	for(std::size_t end; !_stopped && (end = pending.find('\n', begin)) != std::string::npos; begin = end + 1) {
+	    auto line = std::string_view{pending}.substr(begin, end - begin);
+	    if(is_blank(line))
+		continue;
+	    if(!write_all(output, handle(line) + '\n'))
+		return;
+	}
+	pending.erase(0, begin);
+    }
+}
+
+[[nodiscard]] auto compile_server::listen(const std::string& path, unsigned threads) -> bool {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if(path.size() >= sizeof(address.sun_path)) {
+	fprintf(stderr, "error: socket path is too long: \"%s\"\n", path.c_str());
+	return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    _listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if(_listener < 0) {
+	fprintf(stderr, "error: unable to create socket: %s\n", std::strerror(errno));
+	return false;
+    }
+    ::unlink(path.c_str());
+    if(::bind(_listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(_listener, SOMAXCONN) != 0) {
+	fprintf(stderr, "error: unable to listen on \"%s\": %s\n", path.c_str(), std::strerror(errno));
+	::close(_listener);
+	return false;
+    }
+
+    if(::pipe(_wakeup) != 0) {
+	fprintf(stderr, "error: unable to create pipe: %s\n", std::strerror(errno));
+	::close(_listener);
+	return false;
+    }
+
+    // clients may disconnect before they are answered, that must not kill server
+    std::signal(SIGPIPE, SIG_IGN);
+    TRACE(driver, info, "listening on %s", path.c_str());
+
+    llvm::ThreadPool pool{llvm::hardware_concurrency(threads)};
+
+    // worker answers queued requests of connection one after another, so responses keep order of requests
+    auto answer = [this] (std::shared_ptr<connection> client) {
+	for(;;) {
+	    std::string request;
+	    {
+		std::lock_guard lock{client->mutex};
+		if(client->requests.empty() || _stopped) {
+		    client->busy = false;
+		    return;
+		}
+		request = std::move(client->requests.front());
+		client->requests.pop_front();
+	    }
+	    if(!write_all(client->fd, handle(request) + '\n')) {
+		std::lock_guard lock{client->mutex};
+		client->requests.clear();
+		client->busy = false;
+		return;
+	    }
+	}
+    };
+
+    // returns false when client has disconnected
+    auto receive = [&pool, &answer] (const std::shared_ptr<connection>& client) -> bool {
+	char chunk[4096];
+	ssize_t count = ::read(client->fd, chunk, sizeof(chunk));
+	if(count < 0 && errno == EINTR)
+	    return true;
+	bool open = count > 0;
+	if(open)
+	    client->pending.append(chunk, static_cast<std::size_t>(count));
+	else
+	    client->pending += '\n'; // answer last request even if it is not terminated
+
+	std::lock_guard lock{client->mutex};
+	std::size_t begin = 0;
+	for(std::size_t end; (end = client->pending.find('\n', begin)) != std::string::npos; begin = end + 1) {
+	    auto line = std::string_view{client->pending}.substr(begin, end - begin);
+	    if(!is_blank(line))
+		client->requests.emplace_back(line);
+	}
+	client->pending.erase(0, begin);
+	if(!client->requests.empty() && !client->busy) {
+	    client->busy = true;
+	    pool.async(answer, client);
+	}
+	return open;
+    };
+
+    std::vector<std::shared_ptr<connection>> clients;
+    std::vector<pollfd> polled;
+    while(!_stopped) {
+	polled.clear();
+	polled.push_back(pollfd{_wakeup[0], POLLIN, 0});
+	polled.push_back(pollfd{_listener, POLLIN, 0});
+	for(const auto& client: clients)
+	    polled.push_back(pollfd{client->fd, POLLIN, 0});
+
+	if(::poll(polled.data(), polled.size(), -1) < 0) {
+	    if(errno == EINTR)
+		continue;
+	    fprintf(stderr, "error: unable to poll connections: %s\n", std::strerror(errno));
+	    break;
+	}
+	if(polled[0].revents)
+	    break; // server was stopped
+
+	// backwards, so that disconnected client may be replaced by the last one
+	for(std::size_t i = clients.size(); i-- > 0;) {
+	    if(!polled[i + 2].revents)
+		continue;
+	    if(!receive(clients[i])) {
+		clients[i] = std::move(clients.back());
+		clients.pop_back();
+	    }
+	}
+
+	if(polled[1].revents & POLLIN) {
+	    int accepted = ::accept(_listener, nullptr, nullptr);
+	    if(accepted >= 0)
+		clients.push_back(std::make_shared<connection>(accepted));
+	    else if(errno != EINTR && errno != ECONNABORTED)
+		break;
+	}
+    }
+    // requests that are being compiled are answered, queued ones are dropped with their connections
+    clients.clear();
+    pool.wait();
+
+    ::close(_wakeup[0]);
+    ::close(_wakeup[1]);
+    _wakeup[0] = _wakeup[1] = -1;
+    ::close(_listener);
+    _listener = -1;
+    ::unlink(path.c_str());
+    return true;
+}
+
+[[nodiscard]] auto compile_server::handle(std::string_view request) -> std::string {
+    auto parsed = llvm::json::parse(llvm::StringRef{request.data(), request.size()});
+    if(!parsed)
+	return error(nullptr, "invalid request: " + llvm::toString(parsed.takeError()));
+    auto* object = parsed->getAsObject();
+    if(!object)
+	return error(nullptr, "invalid request: expected object");
+
+    llvm::json::Value id = nullptr;
+    if(auto* value = object->get("id"))
+	id = *value;
+
+    if(object->getBoolean("shutdown").getValueOr(false)) {
+	stop();
+	return respond(llvm::json::Object{{"id", std::move(id)}, {"status", "ok"}});
+    }
+
+    auto emit = object->getString("emit").getValueOr("ll");
+    if(emit != "ll" && emit != "bc" && emit != "obj")
+	return error(std::move(id), "unknown emit kind \"" + emit.str() + "\", expected \"ll\", \"bc\" or \"obj\"");
+    if(emit == "obj" && !_target)
+	return error(std::move(id), "server has no target to emit object files for");
+    auto name = object->getString("name").getValueOr("request");
+
+    // context dies with request, so constants and types uniqued by one compilation do not pile up in server
+    llvm::LLVMContext context;
+    std::unique_ptr<llvm::Module> module;
+    if(auto source = object->getString("source"))
+	module = _frontend.compile_text(*source, name, context);
+    else if(auto path = object->getString("path"))
+	module = _frontend.compile_file(*path, name, context);
+    else
+	return error(std::move(id), "request has neither \"source\" nor \"path\"");
+    if(!module)
+	return error(std::move(id), "compilation failed");
+
+    std::string output;
+    if(emit == "bc") {
+	llvm::SmallVector<char, 0> bitcode;
+	llvm::raw_svector_ostream stream{bitcode};
+	llvm::WriteBitcodeToFile(*module, stream);
+	output = llvm::encodeBase64(bitcode);
+    } else if(emit == "obj") {
+	llvm::SmallVector<char, 0> object_file;
+	llvm::raw_svector_ostream stream{object_file};
+	if(!_target->emit_object(*module, stream))
+	    return error(std::move(id), "code generation failed");
+	output = llvm::encodeBase64(object_file);
+    } else {
+	llvm::raw_string_ostream stream{output};
+	module->print(stream, nullptr);
+	stream.flush();
+    }
+    return respond(llvm::json::Object{{"id", std::move(id)}, {"status", "ok"}, {"output", std::move(output)}});
+}
+
+auto compile_server::stop() -> void {
+    _stopped = true;
+    if(_wakeup[1] >= 0) {
+	char byte = 0;
+	(void)!::write(_wakeup[1], &byte, 1); // wakes up poll loop, which disconnects all clients
+    }
+}
@@ -0,0 +1,123 @@
+#include <cstdio>
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include "ast.hpp"
+#include "frontend.hpp"
+#include "interner.hpp"
+#include "lexer.hpp"
+#include "module_compiler.hpp"
+#include "parser.hpp"
+#include "time_report.hpp"
+#include "trace.hpp"
+
+frontend::frontend(unsigned threads, compilation_cache* cache, optimization opt, const code_target* target, operator_table operators)
+    : _threads{threads}
+    , _operators{std::move(operators)}
+    , _precedence{_operators}
+    , _cache{cache}
+    , _optimization{opt}
+    , _target{target}
+    , _configuration{compilation_cache::configuration(_operators, _optimization) + (target ? target->configuration() : "")}
+{}
+
+[[nodiscard]] auto frontend::compile(source_buffer&& source, std::string_view module_name, llvm::LLVMContext& context) const -> std::unique_ptr<llvm::Module> {
+    if(!_cache)
+	return compile_uncached(std::move(source), module_name, context);
+
+    auto key = compilation_cache::key(source.text(), _configuration, module_name);
+    if(auto module = load_cached(key, module_name, context))
+	return module;
+
+    auto module = compile_uncached(std::move(source), module_name, context);
+    if(module) {
+	llvm::SmallVector<char, 0> bitcode;
+	llvm::raw_svector_ostream stream{bitcode};
+	llvm::WriteBitcodeToFile(*module, stream);
+	_cache->store(key, llvm::StringRef{bitcode.data(), bitcode.size()});
+    }
+    return module;
+}
+
+[[nodiscard]] auto frontend::compile_uncached(source_buffer&& source, std::string_view module_name, llvm::LLVMContext& context) const -> std::unique_ptr<llvm::Module> {
+    auto a = ast::arena{};
+    auto p = parser{lexer{std::move(source)}, _precedence, a};
+    std::optional<ast::function_list> functions;
+    {
+	auto timer = time_report::scope{time_report::phase::parse};
+	functions = p.parse_module();
+    }
+    time_report::count(time_report::counter::files, 1);
+    time_report::count(time_report::counter::tokens, p.token_count());
+    time_report::count(time_report::counter::ast_nodes, a.node_count());
+    time_report::count(time_report::counter::ast_bytes, a.node_bytes());
+    if(!functions)
+	return nullptr;
+    time_report::count(time_report::counter::functions, functions->size());
+    TRACE(driver, info, "%.*s: parsed %zu functions", static_cast<int>(module_name.size()), module_name.data(), functions->size());
+
+    auto mc = module_compiler{std::string{module_name}, _threads, _cache, _configuration, _optimization.per_function};
+    auto module = mc.compile(*functions, context);
+    if(module && _target)
+	_target->apply(*module);
+    if(module && _optimization.level != opt_level::O0) {
+	auto timer = time_report::scope{time_report::phase::optimize};
+	optimizer{}.run(*module, _optimization.level);
+	TRACE(driver, info, "%.*s: optimized at -O%d", static_cast<int>(module_name.size()), module_name.data(), static_cast<int>(_optimization.level));
+    }
+    if(module)
+	time_report::count(time_report::counter::instructions, module->getInstructionCount());
+    return module;
+}
+
+[[nodiscard]] auto frontend::compile_file(std::string_view path, std::string_view module_name, llvm::LLVMContext& context) const -> std::unique_ptr<llvm::Module> {
+    std::optional<source_buffer> source;
+    try {
+	source.emplace(path);
+    } catch(const std::runtime_error& e) {
+	fprintf(stderr, "error: %s: \"%.*s\"\n", e.what(), static_cast<int>(path.size()), path.data());
+	return nullptr;
+    }
+    return compile(std::move(*source), module_name, context);
+}
+
+[[nodiscard]] auto frontend::compile_text(std::string_view text, std::string_view module_name, llvm::LLVMContext& context) const -> std::unique_ptr<llvm::Module> {
+    auto buffer = llvm::MemoryBuffer::getMemBufferCopy(llvm::StringRef{text.data(), text.size()}, llvm::StringRef{module_name.data(), module_name.size()});
+    return compile(source_buffer{std::move(buffer)}, module_name, context);
+}
+
+[[nodiscard]] auto frontend::default_operators() -> operator_table {
+    auto t = operator_table{};
+    t[interner::intern("=")] = 0;
+    t[interner::intern("+")] = 2;
+    t[interner::intern("-")] = 2;
+    t[interner::intern("*")] = 3;
+    t[interner::intern("/")] = 3;
+    return t;
+}
+
+[[nodiscard]] auto frontend::load_cached(const std::string& key, std::string_view module_name, llvm::LLVMContext& context) const -> std::unique_ptr<llvm::Module> {
+    auto buffer = _cache->lookup(key);
+    if(!buffer)
+	return nullptr;
+
+    auto module = llvm::parseBitcodeFile(buffer->getMemBufferRef(), context);
+    if(!module) {
+	// corrupted entry is recompiled and overwritten
+	llvm::consumeError(module.takeError());
+	_cache->remove(key);
+	return nullptr;
+    }
+    (*module)->setModuleIdentifier(llvm::StringRef{module_name.data(), module_name.size()}); // reader names module after file of entry
+    time_report::count(time_report::counter::files, 1);
+    time_report::count(time_report::counter::cache_hits, 1);
+    return std::move(*module);
+}
@@ -1,31 +1,25 @@
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <mutex>
+#include <utility>
+
+#include <llvm/IR/Constants.h>
+#include <llvm/IR/IRBuilder.h>
+
 #include "global_context.hpp"
 #include "tables.hpp"
-#include <llvm/IR/IRBuilder.h>
-#include <unordered_map>
+#include "trace.hpp"
 
 namespace {
 
-    auto make_cast_name(const std::string& from, const std::string& to) -> std::string {
-	std::string name(6 + from.size() + to.size(), 0); // cast_`FROM`_`TO`
-	name = "cast_";
-	name += from;
-	name += '_';
-	name += to;
-	return name;
-    }
+    using types::builtin;
+    using types::index;
 
-    auto make_operation_name(const std::string& op, const std::string& type) -> std::string {
-	std::string name(1 + op.size() + type.size(), 0); // `OPERATION`_`TYPE`
-	name = op;
-	name += '_';
-	name += type;
-	return name;
-    }
-
-    auto normalise_type(const std::string& type) -> std::string {
+    auto normalise_type(symbol type) -> symbol {
 	static const type_normalization_table normalization_table = {
-	    {"int", "int32"},
-	    {"uint", "uint32"},
+	    {interner::intern("int"), interner::intern("int32")},
+	    {interner::intern("uint"), interner::intern("uint32")},
 	};
 
 	if(auto it = normalization_table.find(type); it != normalization_table.end())
@@ -33,18 +27,258 @@ namespace {
 	return type;
     }
 
+    [[nodiscard]] constexpr auto is_signed(builtin id) noexcept -> bool {
+	return !(builtin::uint8 <= id && id <= builtin::uint128) && id != builtin::character;
+    }
+
+    /**
+     * Get LLVM type of builtin type in given context
+     */
+    auto llvm_type(builtin id, llvm::LLVMContext& context) -> llvm::Type* {
+	switch(id) {
+	    case builtin::void_type: return llvm::Type::getVoidTy(context);
+	    case builtin::boolean:   return llvm::Type::getInt1Ty(context);
+	    case builtin::byte:      return llvm::Type::getInt8Ty(context);
+	    case builtin::int8:      return llvm::Type::getInt8Ty(context);
+	    case builtin::int16:     return llvm::Type::getInt16Ty(context);
+	    case builtin::int32:     return llvm::Type::getInt32Ty(context);
+	    case builtin::int64:     return llvm::Type::getInt64Ty(context);
+	    case builtin::int128:    return llvm::Type::getInt128Ty(context);
+	    case builtin::uint8:     return llvm::Type::getInt8Ty(context);
+	    case builtin::uint16:    return llvm::Type::getInt16Ty(context);
+	    case builtin::uint32:    return llvm::Type::getInt32Ty(context);
+	    case builtin::uint64:    return llvm::Type::getInt64Ty(context);
+	    case builtin::uint128:   return llvm::Type::getInt128Ty(context);
+	    case builtin::float32:   return llvm::Type::getFloatTy(context);
+	    case builtin::float64:   return llvm::Type::getDoubleTy(context);
+	    case builtin::character: return llvm::Type::getInt8Ty(context);
+	    case builtin::string:    return llvm::Type::getInt8PtrTy(context);
+	    default:                 return nullptr;
+	}
+    }
+
+    namespace casts {
+
+	enum class kind : uint8_t {
+	    none,             ///< there is no implicit cast
+	    integer,          ///< extension or truncation of integer
+	    integer_to_bool,  ///< comparison of integer with zero
+	    fp_extend,        ///< float to double
+	    fp_to_bool,       ///< comparison of floating point with zero
+	    signed_to_fp,     ///< signed integer to floating point
+	    unsigned_to_fp,   ///< unsigned integer to floating point
+	};
+
+	using kind_matrix = std::array<std::array<kind, types::builtin_count>, types::builtin_count>;
+
+	/**
+	 * Build matrix of implicit casts, rows are types to cast from, columns are types to cast to
+	 */
+	constexpr auto make_kinds() -> kind_matrix {
+	    kind_matrix kinds{};
+
+	    auto int_casts = [&kinds] (builtin from, std::initializer_list<builtin> to_types) {
+		for(auto to: to_types)
+		    kinds[index(from)][index(to)] = to == builtin::boolean ? kind::integer_to_bool : kind::integer;
+	    };
+	    auto fp_casts = [&kinds] (builtin from, std::initializer_list<builtin> to_types) {
+		for(auto to: to_types)
+		    kinds[index(from)][index(to)] =
+			from == builtin::float32 && to == builtin::float64 ? kind::fp_extend :
+			to == builtin::boolean                              ? kind::fp_to_bool :
+			is_signed(from)                                     ? kind::signed_to_fp : kind::unsigned_to_fp;
+	    };
+	    const std::initializer_list<builtin> to_fp = {builtin::float32, builtin::float64};
+
+	    int_casts(builtin::boolean, {builtin::byte, builtin::int8, builtin::int16, builtin::int32, builtin::int64, builtin::int128,
+		    builtin::uint8, builtin::uint16, builtin::uint32, builtin::uint64, builtin::uint128});
+	    // maybe add bool to float casts
+
+	    int_casts(builtin::byte, {builtin::boolean, builtin::int8, builtin::int16, builtin::int32, builtin::int64, builtin::int128,
+		    builtin::uint8, builtin::uint16, builtin::uint32, builtin::uint64, builtin::uint128, builtin::character});
+
+	    int_casts(builtin::int8, {builtin::boolean, builtin::byte, builtin::int16, builtin::int32, builtin::int64, builtin::int128});
+	    fp_casts(builtin::int8, to_fp);
+
+	    int_casts(builtin::uint8, {builtin::boolean, builtin::byte, builtin::int16, builtin::int32, builtin::int64, builtin::int128,
+		    builtin::uint16, builtin::uint32, builtin::uint64, builtin::uint128});
+	    fp_casts(builtin::uint8, to_fp);
+
+	    int_casts(builtin::int16, {builtin::boolean, builtin::int32, builtin::int64, builtin::int128});
+	    fp_casts(builtin::int16, to_fp);
+
+	    int_casts(builtin::uint16, {builtin::boolean, builtin::int32, builtin::int64, builtin::int128, builtin::uint32, builtin::uint64, builtin::uint128});
+	    fp_casts(builtin::uint16, to_fp);
+
+	    int_casts(builtin::int32, {builtin::boolean, builtin::int64, builtin::int128});
+	    fp_casts(builtin::int32, to_fp);
+
+	    int_casts(builtin::uint32, {builtin::boolean, builtin::int64, builtin::int128, builtin::uint64, builtin::uint128});
+	    fp_casts(builtin::uint32, to_fp);
+
+	    int_casts(builtin::int64, {builtin::boolean, builtin::int128});
+	    fp_casts(builtin::int64, to_fp);
+
+	    int_casts(builtin::uint64, {builtin::boolean, builtin::int128, builtin::uint128});
+	    fp_casts(builtin::uint64, to_fp);
+
+	    int_casts(builtin::int128, {builtin::boolean});
+	    fp_casts(builtin::int128, to_fp);
+
+	    int_casts(builtin::uint128, {builtin::boolean});
+	    fp_casts(builtin::uint128, to_fp);
+
+	    fp_casts(builtin::float32, {builtin::boolean, builtin::float64});
+
+	    fp_casts(builtin::float64, {builtin::boolean});
+
+	    int_casts(builtin::character, {builtin::boolean, builtin::byte});
+
+	    // add string to bool
+
+	    return kinds;
+	}
+
+	constexpr kind_matrix kinds = make_kinds();
+
+	/**
+	 * Name of value produced by cast i.e. cast_`FROM`_`TO`, null-terminated
+	 */
+	template<builtin From, builtin To>
+	constexpr auto name = [] {
+	    constexpr std::string_view prefix = "cast_", from = types::builtin_spellings[index(From)], to = types::builtin_spellings[index(To)];
+	    std::array<char, prefix.size() + from.size() + 1 + to.size() + 1> result{};
+	    auto out = std::ranges::copy(prefix, result.begin()).out;
+	    out = std::ranges::copy(from, out).out;
+	    *out++ = '_';
+	    std::ranges::copy(to, out);
+	    return result;
+	}();
+
+	template<builtin From, builtin To>
+	auto cast(llvm::IRBuilderBase* b, llvm::Value* v) -> llvm::Value* {
+	    constexpr kind cast_kind = kinds[index(From)][index(To)];
+	    const char* cast_name = name<From, To>.data();
+
+	    if constexpr(cast_kind == kind::integer)
+		return b->CreateIntCast(v, llvm_type(To, b->getContext()), is_signed(From) && is_signed(To), cast_name);
+	    else if constexpr(cast_kind == kind::integer_to_bool)
+		return b->CreateICmpNE(v, llvm::Constant::getNullValue(v->getType()), cast_name);
+	    else if constexpr(cast_kind == kind::fp_extend)
+		return b->CreateFPExt(v, llvm_type(To, b->getContext()), cast_name);
+	    else if constexpr(cast_kind == kind::fp_to_bool)
+		return b->CreateFCmpUNE(v, llvm::Constant::getNullValue(v->getType()), cast_name);
+	    else if constexpr(cast_kind == kind::signed_to_fp)
+		return b->CreateSIToFP(v, llvm_type(To, b->getContext()), cast_name);
+	    else
+		return b->CreateUIToFP(v, llvm_type(To, b->getContext()), cast_name);
+	}
+
+	template<builtin From, builtin To>
+	constexpr auto entry() -> cast_function* {
+	    if constexpr(kinds[index(From)][index(To)] == kind::none)
+		return nullptr;
+	    else
+		return &cast<From, To>;
+	}
+
+	template<std::size_t From, std::size_t... To>
+	constexpr auto make_row(std::index_sequence<To...>) -> std::array<cast_function*, types::builtin_count> {
+	    return {entry<static_cast<builtin>(From), static_cast<builtin>(To)>()...};
+	}
+
+	template<std::size_t... From>
+	constexpr auto make_dispatch(std::index_sequence<From...>) {
+	    return std::array{make_row<From>(std::make_index_sequence<types::builtin_count>{})...};
+	}
+
+	constexpr auto dispatch = make_dispatch(std::make_index_sequence<types::builtin_count>{}); ///< cast function of every pair of builtin types
+
+    }
+
+    namespace operations {
+
+	/**
+	 * Builtin binary operators
+	 */
+	enum class op : uint8_t {
+	    add,
+	    sub,
+	    mul,
+	    div,
+	};
+
+	constexpr std::array<std::string_view, 4> spellings = {"+", "-", "*", "/"};
+
+	auto add(llvm::IRBuilderBase* b, llvm::Value* lhs, llvm::Value* rhs) -> llvm::Value*  { return b->CreateAdd(lhs, rhs, "add"); }
+	auto fadd(llvm::IRBuilderBase* b, llvm::Value* lhs, llvm::Value* rhs) -> llvm::Value* { return b->CreateFAdd(lhs, rhs, "add"); }
+	auto sub(llvm::IRBuilderBase* b, llvm::Value* lhs, llvm::Value* rhs) -> llvm::Value*  { return b->CreateSub(lhs, rhs, "sub"); }
+	auto fsub(llvm::IRBuilderBase* b, llvm::Value* lhs, llvm::Value* rhs) -> llvm::Value* { return b->CreateFSub(lhs, rhs, "sub"); }
+	auto mul(llvm::IRBuilderBase* b, llvm::Value* lhs, llvm::Value* rhs) -> llvm::Value*  { return b->CreateMul(lhs, rhs, "mul"); }
+	auto fmul(llvm::IRBuilderBase* b, llvm::Value* lhs, llvm::Value* rhs) -> llvm::Value* { return b->CreateFMul(lhs, rhs, "mul"); }
+	auto sdiv(llvm::IRBuilderBase* b, llvm::Value* lhs, llvm::Value* rhs) -> llvm::Value* { return b->CreateSDiv(lhs, rhs, "div"); }
+	auto udiv(llvm::IRBuilderBase* b, llvm::Value* lhs, llvm::Value* rhs) -> llvm::Value* { return b->CreateUDiv(lhs, rhs, "div"); }
+	auto fdiv(llvm::IRBuilderBase* b, llvm::Value* lhs, llvm::Value* rhs) -> llvm::Value* { return b->CreateFDiv(lhs, rhs, "div"); }
+
+	using matrix = std::array<std::array<binary_operation_function*, types::builtin_count>, spellings.size()>;
+
+	/**
+	 * Build matrix of operations, rows are operators, columns are types of operands
+	 */
+	constexpr auto make_dispatch() -> matrix {
+	    matrix dispatch{};
+
+	    auto define = [&dispatch] (op o, binary_operation_function* function, std::initializer_list<builtin> operand_types) {
+		for(auto type: operand_types)
+		    dispatch[static_cast<std::size_t>(o)][index(type)] = function;
+	    };
+	    const std::initializer_list<builtin> integers = {builtin::byte, builtin::int8, builtin::int16, builtin::int32, builtin::int64, builtin::int128,
+		builtin::uint8, builtin::uint16, builtin::uint32, builtin::uint64, builtin::uint128};
+	    const std::initializer_list<builtin> signed_integers = {builtin::int8, builtin::int16, builtin::int32, builtin::int64, builtin::int128};
+	    const std::initializer_list<builtin> unsigned_integers = {builtin::byte, builtin::uint8, builtin::uint16, builtin::uint32, builtin::uint64, builtin::uint128};
+	    const std::initializer_list<builtin> floating_points = {builtin::float32, builtin::float64};
+
+	    define(op::add, add, integers);
+	    define(op::add, fadd, floating_points);
+
+	    define(op::sub, sub, integers);
+	    define(op::sub, fsub, floating_points);
+
+	    define(op::mul, mul, integers);
+	    define(op::mul, fmul, floating_points);
+
+	    define(op::div, sdiv, signed_integers);
+	    define(op::div, udiv, unsigned_integers);
+	    define(op::div, fdiv, floating_points);
+
+	    return dispatch;
+	}
+
+	constexpr matrix dispatch = make_dispatch(); ///< operation function of every builtin operator and type
+
+	/**
+	 * Get row of operator in dispatch matrix
+	 * @return index of operator or number of operators if it is not builtin
+	 */
+	auto find(symbol operation) -> std::size_t {
+	    static const auto symbols = [] {
+		std::array<symbol, spellings.size()> result{};
+		std::ranges::transform(spellings, result.begin(), interner::intern);
+		return result;
+	    }();
+	    return static_cast<std::size_t>(std::ranges::find(symbols, operation) - symbols.begin());
+	}
+
+    }
+
 }
 
 
 global_context::global_context() 
     : _context{std::make_unique<llvm::LLVMContext>()}
+    , _types{make_default_types(*_context)}
 {
-    fprintf(stderr, "creating global_context\n");
-    add_default_types();
-    fprintf(stderr, "added default types\n");
-    add_default_casts();
-    fprintf(stderr, "added default casts\n");
-    add_default_operations();
+    TRACE(driver, info, "created global_context");
 }
 
 auto global_context::instance() -> global_context& {
@@ -57,21 +291,33 @@ auto global_context::instance() -> global_context& {
 }
 
 [[nodiscard]] auto global_context::context() -> llvm::LLVMContext& {
-    return instance().get();
+    thread_local llvm::LLVMContext thread_context{};
+    return thread_context;
+}
+
+[[nodiscard]] auto global_context::get_type(symbol type_name) const -> types::type* {
+    auto found = _types.find(normalise_type(type_name));
+    return found != _types.end() ? found->second.get() : nullptr;
+}
+
+[[nodiscard]] auto global_context::type(symbol type_name) -> types::type* {
+    return instance().get_type(type_name);
 }
 
-[[nodiscard]] auto global_context::get_type(const std::string& type_name) -> types::type* {
-    return _types[normalise_type(type_name)].get();
+[[nodiscard]] auto global_context::get_type(std::string_view type_name) const -> types::type* {
+    return get_type(interner::intern(type_name));
 }
 
-[[nodiscard]] auto global_context::type(const std::string& type_name) -> types::type* {
+[[nodiscard]] auto global_context::type(std::string_view type_name) -> types::type* {
     return instance().get_type(type_name);
 }
 
-[[nodiscard]] auto global_context::get_type(const std::vector<std::string>& arg_types, const std::string& ret_type) -> types::function_type* {
-    auto& func_type = _function_types[std::make_pair(arg_types, ret_type)];
-    if(func_type)
-	return func_type.get();
+[[nodiscard]] auto global_context::get_type(std::span<const symbol> arg_types, symbol ret_type) -> types::function_type* {
+    {
+	std::shared_lock lock{_function_types_mutex};
+	if(auto found = _function_types.find(std::make_pair(arg_types, ret_type)); found != _function_types.end())
+	    return found->second.get();
+    }
 
     std::vector<types::type*> param_types;
     for(const auto& arg_type: arg_types) {
@@ -79,323 +325,60 @@ auto global_context::instance() -> global_context& {
 	if(!param_types.back())
 	    return nullptr;
     }
-
-    func_type = std::make_unique<types::function_type>(param_types, get_type(ret_type));
+    auto return_type = get_type(ret_type);
+    if(!return_type)
+	return nullptr;
+
+    // type may have been added by another thread since the lookup, keep the first one
+    std::unique_lock lock{_function_types_mutex};
+    auto& func_type = _function_types[std::make_pair(std::vector<symbol>(arg_types.begin(), arg_types.end()), ret_type)];
+    if(!func_type)
+	func_type = std::make_unique<types::function_type>(param_types, return_type);
     return func_type.get();
 }
 
-[[nodiscard]] auto global_context::type(const std::vector<std::string>& arg_types, const std::string& ret_type) -> types::function_type* {
+[[nodiscard]] auto global_context::type(std::span<const symbol> arg_types, symbol ret_type) -> types::function_type* {
     return instance().get_type(arg_types, ret_type);
 }
 
-[[nodiscard]] auto global_context::get_cast(types::type* from, types::type* to) -> const std::function<cast_function>& {
-    return _casts[std::make_pair(from, to)];
+[[nodiscard]] auto global_context::get_cast(types::type* from, types::type* to) const -> cast_function* {
+    if(!from || !to || from->id() == builtin::none || to->id() == builtin::none)
+	return nullptr;
+    return casts::dispatch[index(from->id())][index(to->id())];
 }
 
-[[nodiscard]] auto global_context::cast(types::type* from, types::type* to) -> const std::function<cast_function>& {
+[[nodiscard]] auto global_context::cast(types::type* from, types::type* to) -> cast_function* {
     return instance().get_cast(from, to);
 }
 
-[[nodiscard]] auto global_context::get_binary_operation(const std::string& op, types::type* type) -> const std::function<binary_operation_function>& {
-    return _binary_operation_table[std::make_pair(op, type)];
+[[nodiscard]] auto global_context::get_binary_operation(symbol op, types::type* type) const -> binary_operation_function* {
+    auto row = operations::find(op);
+    if(row == operations::dispatch.size() || !type || type->id() == builtin::none)
+	return nullptr;
+    return operations::dispatch[row][index(type->id())];
 }
 
-[[nodiscard]] auto global_context::binary_operation(const std::string& op, types::type* type) -> const std::function<binary_operation_function>& {
+[[nodiscard]] auto global_context::binary_operation(symbol op, types::type* type) -> binary_operation_function* {
     return instance().get_binary_operation(op, type);
 }
 
-auto global_context::add_default_types() -> void {
-    _types[""]        = std::make_unique<types::type>(llvm::Type::getVoidTy(get()), "(void)");
-
-    _types["bool"]    = std::make_unique<types::type>(llvm::Type::getInt1Ty(get()), "bool");
-
-    _types["byte"]    = std::make_unique<types::type>(llvm::Type::getInt8Ty(get()), "byte");
-
-    _types["int"]     = std::make_unique<types::signed_integer_type>(llvm::Type::getInt32Ty(get()), "int");
-    _types["int8"]    = std::make_unique<types::signed_integer_type>(llvm::Type::getInt8Ty(get()), "int8");
-    _types["int16"]   = std::make_unique<types::signed_integer_type>(llvm::Type::getInt16Ty(get()), "int16");
-    _types["int32"]   = std::make_unique<types::signed_integer_type>(llvm::Type::getInt32Ty(get()), "int32");
-    _types["int64"]   = std::make_unique<types::signed_integer_type>(llvm::Type::getInt64Ty(get()), "int64");
-    _types["int128"]  = std::make_unique<types::signed_integer_type>(llvm::Type::getInt128Ty(get()), "int128");
-
-    _types["uint"]    = std::make_unique<types::unsigned_integer_type>(llvm::Type::getInt32Ty(get()), "uint");
-    _types["uint8"]   = std::make_unique<types::unsigned_integer_type>(llvm::Type::getInt8Ty(get()), "uint8");
-    _types["uint16"]  = std::make_unique<types::unsigned_integer_type>(llvm::Type::getInt16Ty(get()), "uint16");
-    _types["uint32"]  = std::make_unique<types::unsigned_integer_type>(llvm::Type::getInt32Ty(get()), "uint32");
-    _types["uint64"]  = std::make_unique<types::unsigned_integer_type>(llvm::Type::getInt64Ty(get()), "uint64");
-    _types["uint128"] = std::make_unique<types::unsigned_integer_type>(llvm::Type::getInt128Ty(get()), "uint128");
-
-    _types["float"]   = std::make_unique<types::type>(llvm::Type::getFloatTy(get()), "float");
-    _types["double"]  = std::make_unique<types::type>(llvm::Type::getDoubleTy(get()), "double");
-
-    _types["char"]    = std::make_unique<types::unsigned_integer_type>(llvm::Type::getInt8Ty(get()), "char");
-    _types["string"]  = std::make_unique<types::type>(llvm::Type::getInt8PtrTy(get()), "string");
-}
-
-auto global_context::add_default_casts() -> void {
-    // ---------------------------------------- bool ------------------------------------------
-
-    auto from = "bool";
-    std::vector cast_to = {"byte", "int8", "int16", "int32", "int64", "int128", "uint8", "uint16", "uint32", "uint64", "uint128"};
-    const std::array cast_to_fp = {"float", "double"};
-
-    for(const char* to: cast_to)
-	add_int_cast(from, to);
-
-    // maybe add bool to float casts
-
-    // ---------------------------------------- byte ------------------------------------------
-
-    from = "byte";
-    cast_to = {"bool", "int8", "int16", "int32", "int64", "int128", "uint8", "uint16", "uint32", "uint64", "uint128", "char"};
-
-    for(const char* to: cast_to)
-	add_int_cast(from, to);
-
-    // ---------------------------------------- int8 ------------------------------------------
-
-    from = "int8";
-    cast_to = {"bool", "byte", "int16", "int32", "int64", "int128"};
-
-    for(const char* to: cast_to)
-	add_int_cast(from, to);
-
-    for(const char* to: cast_to_fp)
-	add_fp_cast(from, to);
-
-
-    // ---------------------------------------- uint8 -----------------------------------------
-
-    from = "uint8";
-    cast_to = {"bool", "byte", "int16", "int32", "int64", "int128", "uint16", "uint32", "uint64", "uint128"};
-
-    for(const char* to: cast_to)
-	add_int_cast(from, to);
-
-    for(const char* to: cast_to_fp)
-	add_fp_cast(from, to);
-
-
-    // ---------------------------------------- int16 -----------------------------------------
-                                                                                              
-    from = "int16";
-    cast_to = {"bool", "int32", "int64", "int128"};
-
-    for(const char* to: cast_to)
-	add_int_cast(from, to);
-
-    for(const char* to: cast_to_fp)
-	add_fp_cast(from, to);
-
-
-    // ---------------------------------------- uint16 ----------------------------------------
-                                                                                              
-    from = "uint16";
-    cast_to = {"bool", "int32", "int64", "int128", "uint32", "uint64", "uint128"};
-
-    for(const char* to: cast_to)
-	add_int_cast(from, to);
-
-    for(const char* to: cast_to_fp)
-	add_fp_cast(from, to);
-
-
-    // ---------------------------------------- int32 -----------------------------------------
-                                                                                              
-    from = "int32";
-    cast_to = {"bool", "int64", "int128"};
-
-    for(const char* to: cast_to)
-	add_int_cast(from, to);
-
-    for(const char* to: cast_to_fp)
-	add_fp_cast(from, to);
-
-                                                                                              
-    // ---------------------------------------- uint32 ----------------------------------------
-                                                                                              
-    from = "uint32";
-    cast_to = {"bool", "int64", "int128", "uint64", "uint128"};
-
-    for(const char* to: cast_to)
-	add_int_cast(from, to);
-
-    for(const char* to: cast_to_fp)
-	add_fp_cast(from, to);
-
-                                                                                              
-    // ---------------------------------------- int64 -----------------------------------------
-
-    from = "int64";
-    cast_to = {"bool", "int128"};
-
-    for(const char* to: cast_to)
-	add_int_cast(from, to);
-
-    for(const char* to: cast_to_fp)
-	add_fp_cast(from, to);
-
-
-    // ---------------------------------------- uint64 ----------------------------------------
-
-    from = "uint64";
-    cast_to = {"bool", "int128", "uint128"};
-
-    for(const char* to: cast_to)
-	add_int_cast(from, to);
-
-    for(const char* to: cast_to_fp)
-	add_fp_cast(from, to);
-
-
-    // ---------------------------------------- int128 ----------------------------------------
-
-    from = "int128";
-
-    add_int_cast(from, "bool");
-
-    for(const char* to: cast_to_fp)
-	add_fp_cast(from, to);
-
-
-    // ---------------------------------------- uint128 ---------------------------------------
-
-    from = "uint128";
-
-    add_int_cast(from, "bool");
-
-    for(const char* to: cast_to_fp)
-	add_fp_cast(from, to);
-
-
-    // ---------------------------------------- float -----------------------------------------
-
-    from = "float";
-
-    add_int_cast(from, "bool");
-    add_fp_cast(from, "double");
-
-    // ---------------------------------------- double ----------------------------------------
-
-    add_fp_cast("double", "bool");
-
-
-    // ---------------------------------------- char ------------------------------------------
-
-    from = "char";
-    cast_to = {"bool", "byte"};
-
-    for(const char* to: cast_to)
-	add_int_cast(from, to);
-
-
-    // ---------------------------------------- string ----------------------------------------
-
-    // add string to bool
-
-}
-
-auto global_context::add_default_operations() -> void {
-    // --------------------------------------- addition ---------------------------------------
-    
-    for(const char* type: {"byte", "int8", "int16", "int32", "int64", "int128", "uint8", "uint16", "uint32", "uint64", "uint128"})
-	_binary_operation_table[std::make_pair("+", get_type(type))] = [] (llvm::IRBuilderBase* b, llvm::Value* lhs, llvm::Value* rhs) {
-	    return b->CreateAdd(lhs, rhs, "add");
-	};
-
-    for(const char* type: {"float", "double"})
-	_binary_operation_table[std::make_pair("+", get_type(type))] = [] (llvm::IRBuilderBase* b, llvm::Value* lhs, llvm::Value* rhs) {
-	    return b->CreateFAdd(lhs, rhs, "add");
-	};
-
-
-    // ------------------------------------- substruction --------------------------------------
-    
-    for(const char* type: {"byte", "int8", "int16", "int32", "int64", "int128", "uint8", "uint16", "uint32", "uint64", "uint128"})
-	_binary_operation_table[std::make_pair("-", get_type(type))] = [] (llvm::IRBuilderBase* b, llvm::Value* lhs, llvm::Value* rhs) {
-	    return b->CreateSub(lhs, rhs, "sub");
-	};
-
-    for(const char* type: {"float", "double"})
-	_binary_operation_table[std::make_pair("-", get_type(type))] = [] (llvm::IRBuilderBase* b, llvm::Value* lhs, llvm::Value* rhs) {
-	    return b->CreateFSub(lhs, rhs, "sub");
-	};
-
-
-
-    // ------------------------------------- mutiplication --------------------------------------
-    
-    for(const char* type: {"byte", "int8", "int16", "int32", "int64", "int128", "uint8", "uint16", "uint32", "uint64", "uint128"})
-	_binary_operation_table[std::make_pair("*", get_type(type))] = [] (llvm::IRBuilderBase* b, llvm::Value* lhs, llvm::Value* rhs) {
-	    return b->CreateMul(lhs, rhs, "mul");
-	};
-
-    for(const char* type: {"float", "double"})
-	_binary_operation_table[std::make_pair("*", get_type(type))] = [] (llvm::IRBuilderBase* b, llvm::Value* lhs, llvm::Value* rhs) {
-	    return b->CreateFMul(lhs, rhs, "mul");
-	};
-
-
-
-    // --------------------------------------- division ----------------------------------------
-    
-    for(const char* type: {"int8", "int16", "int32", "int64", "int128"})
-	_binary_operation_table[std::make_pair("/", get_type(type))] = [] (llvm::IRBuilderBase* b, llvm::Value* lhs, llvm::Value* rhs) {
-	    return b->CreateSDiv(lhs, rhs, "div");
-	};
-
-    for(const char* type: {"byte", "uint8", "uint16", "uint32", "uint64", "uint128"})
-	_binary_operation_table[std::make_pair("/", get_type(type))] = [] (llvm::IRBuilderBase* b, llvm::Value* lhs, llvm::Value* rhs) {
-	    return b->CreateUDiv(lhs, rhs, "div");
-	};
-
-    for(const char* type: {"float", "double"})
-	_binary_operation_table[std::make_pair("/", get_type(type))] = [] (llvm::IRBuilderBase* b, llvm::Value* lhs, llvm::Value* rhs) {
-	    return b->CreateFDiv(lhs, rhs, "div");
-	};
-
-
-}
-
-auto global_context::add_int_cast(std::string&& from, std::string&& to) -> void {
-    auto name = make_cast_name(from, to);
-
-    auto from_type = get_type(std::move(from));
-    auto to_type = get_type(std::move(to));
-    auto key = std::make_pair(from_type, to_type);
-    auto is_signed = from_type->is_signed() && to_type->is_signed();
-
-    if(to == "bool")
-	_casts[key] = [llvm_type = to_type->get(), name = std::move(name)] (llvm::IRBuilderBase* b, llvm::Value* v) {
-	    return b->CreateICmpNE(v, llvm::ConstantInt::get(llvm_type, 0), name);
-	};
-    else
-	_casts[key] = [llvm_type = to_type->get(), name = std::move(name), is_signed] (llvm::IRBuilderBase* b, llvm::Value* v) {
-	    return b->CreateIntCast(v, llvm_type, is_signed, name);
-	};
-}
-
-auto global_context::add_fp_cast(std::string&& from, std::string&& to) -> void {
-    auto name = make_cast_name(from, to);
-
-    auto from_type = get_type(std::move(from));
-    auto to_type = get_type(std::move(to));
-    auto key = std::make_pair(from_type, to_type);
+[[nodiscard]] auto global_context::make_default_types(llvm::LLVMContext& context) -> type_table {
+    type_table table{};
+
+    for(std::size_t i = 0; i < types::builtin_count; ++i) {
+	auto id = static_cast<builtin>(i);
+	auto spelling = types::builtin_spellings[i];
+	auto name = id == builtin::void_type ? std::string{"(void)"} : std::string{spelling};
+	auto type = llvm_type(id, context);
+
+	auto& entry = table[interner::intern(spelling)];
+	if(!type->isIntegerTy() || id == builtin::boolean || id == builtin::byte)
+	    entry = std::make_unique<types::type>(type, std::move(name), id);
+	else if(is_signed(id))
+	    entry = std::make_unique<types::signed_integer_type>(static_cast<llvm::IntegerType*>(type), std::move(name), id);
+	else
+	    entry = std::make_unique<types::unsigned_integer_type>(static_cast<llvm::IntegerType*>(type), std::move(name), id);
+    }
 
-    if(from == "float" && to == "double")
-	_casts[key] = [llvm_type = to_type->get(), name = std::move(name)] (llvm::IRBuilderBase* b, llvm::Value* v) {
-	    return b->CreateFPExt(v, llvm_type, name);
-	};
-    else if(to == "bool")
-	_casts[key] = [&context = get(), name = std::move(name)] (llvm::IRBuilderBase* b, llvm::Value* v) {
-	    return b->CreateFCmpULT(v, llvm::ConstantFP::get(context, llvm::APFloat(0.f)), name);
-	};
-    else if(from_type->is_signed())
-	_casts[key] = [llvm_type = to_type->get(), name = std::move(name)] (llvm::IRBuilderBase* b, llvm::Value* v) {
-	    return b->CreateSIToFP(v, llvm_type, name);
-	};
-    else
-	_casts[key] = [llvm_type = to_type->get(), name = std::move(name)] (llvm::IRBuilderBase* b, llvm::Value* v) {
-	    return b->CreateUIToFP(v, llvm_type, name);
-	};
+    return table;
 }
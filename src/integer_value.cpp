@@ -0,0 +1,110 @@
+#include <bit>
+#include <cstring>
+
+#include "integer_value.hpp"
+
+namespace {
+
+    using u128 = unsigned __int128;
+
+    constexpr u128 u128_max = ~u128{0};
+
+    /**
+     * Get value of digit in any radix up to 16, or 16 if character is not a digit
+     */
+    constexpr auto digit_value(char ch) noexcept -> unsigned {
+	if(ch >= '0' && ch <= '9')
+	    return static_cast<unsigned>(ch - '0');
+	ch = static_cast<char>(ch | 0x20); // lower case
+	if(ch >= 'a' && ch <= 'f')
+	    return static_cast<unsigned>(ch - 'a' + 10);
+	return 16;
+    }
+
+    /**
+     * Check if all eight bytes of word are decimal digits
+     */
+    constexpr auto eight_digits(uint64_t word) noexcept -> bool {
+	return ((word & 0xf0f0f0f0f0f0f0f0) | (((word + 0x0606060606060606) & 0xf0f0f0f0f0f0f0f0) >> 4)) == 0x3333333333333333;
+    }
+
+    /**
+     * Convert eight decimal digits loaded in little endian order, first digit is the most significant one
+     */
+    constexpr auto convert_eight_digits(uint64_t word) noexcept -> uint64_t {
+	word -= 0x3030303030303030;
+	word = word * 10 + (word >> 8);                                      // pairs of digits
+	word = (((word & 0x000000ff000000ff) * (100 + (1000000ull << 32)))   // quadruples of digits
+	      + (((word >> 16) & 0x000000ff000000ff) * (1 + (10000ull << 32)))) >> 32;
+	return word;
+    }
+
+    auto parse_decimal(std::string_view digits) noexcept -> std::optional<u128> {
+	constexpr u128 chunk_limit = u128_max / 100'000'000;
+	constexpr u128 digit_limit = u128_max / 10;
+
+	u128 value = 0;
+	const char* it = digits.data();
+	const char* end = it + digits.size();
+	while(it != end) {
+	    if constexpr(std::endian::native == std::endian::little) {
+		uint64_t word;
+		if(end - it >= 8 && (std::memcpy(&word, it, sizeof(word)), eight_digits(word))) {
+		    if(value > chunk_limit)
+			return std::nullopt;
+		    u128 shifted = value * 100'000'000;
+		    value = shifted + convert_eight_digits(word);
+		    if(value < shifted)
+			return std::nullopt;
+		    it += 8;
+		    continue;
+		}
+	    }
+
+	    char ch = *it++;
+	    if(ch == '_')
+		continue;
+	    unsigned digit = digit_value(ch);
+	    if(digit > 9 || value > digit_limit)
+		return std::nullopt;
+	    u128 shifted = value * 10;
+	    value = shifted + digit;
+	    if(value < shifted)
+		return std::nullopt;
+	}
+	return value;
+    }
+
+    auto parse_power_of_two(std::string_view digits, unsigned radix) noexcept -> std::optional<u128> {
+	const unsigned bits = static_cast<unsigned>(std::countr_zero(radix));
+	u128 value = 0;
+	for(char ch: digits) {
+	    if(ch == '_')
+		continue;
+	    unsigned digit = digit_value(ch);
+	    if(digit >= radix || (value >> (128 - bits)) != 0)
+		return std::nullopt;
+	    value = (value << bits) | digit;
+	}
+	return value;
+    }
+
+}
+
+[[nodiscard]] auto integer_value::bit_width() const noexcept -> unsigned {
+    return words[1] ? 64 + static_cast<unsigned>(std::bit_width(words[1])) : static_cast<unsigned>(std::bit_width(words[0]));
+}
+
+[[nodiscard]] auto integer_value::parse(std::string_view digits, uint8_t radix) noexcept -> std::optional<integer_value> {
+    std::optional<u128> value;
+    switch(radix) {
+	case 2:
+	case 8:
+	case 16: value = parse_power_of_two(digits, radix); break;
+	case 10: value = parse_decimal(digits); break;
+	default: return std::nullopt;
+    }
+    if(!value)
+	return std::nullopt;
+    return integer_value{{static_cast<uint64_t>(*value), static_cast<uint64_t>(*value >> 64)}};
+}
@@ -0,0 +1,40 @@
+#include <mutex>
+
+#include "interner.hpp"
+
+interner::interner() {
+    [[maybe_unused]] auto empty = get_symbol("");
+}
+
+auto interner::instance() -> interner& {
+    static interner _interner{};
+    return _interner;
+}
+
+[[nodiscard]] auto interner::get_symbol(std::string_view spelling) -> symbol {
+    llvm::StringRef key{spelling.data(), spelling.size()};
+    {
+	std::shared_lock lock{_mutex};
+	if(auto found = _symbols.find(key); found != _symbols.end())
+	    return found->second;
+    }
+
+    std::unique_lock lock{_mutex};
+    auto [entry, inserted] = _symbols.try_emplace(key, static_cast<symbol>(_spellings.size()));
+    if(inserted)
+	_spellings.emplace_back(entry->getKeyData(), entry->getKeyLength());
+    return entry->second;
+}
+
+[[nodiscard]] auto interner::intern(std::string_view spelling) -> symbol {
+    return instance().get_symbol(spelling);
+}
+
+[[nodiscard]] auto interner::get_spelling(symbol sym) const -> std::string_view {
+    std::shared_lock lock{_mutex};
+    return _spellings[static_cast<uint32_t>(sym)];
+}
+
+[[nodiscard]] auto interner::spelling(symbol sym) -> std::string_view {
+    return instance().get_spelling(sym);
+}
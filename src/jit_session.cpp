@@ -0,0 +1,200 @@
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/TargetSelect.h>
+
+#include "jit_session.hpp"
+#include "trace.hpp"
+
+namespace {
+
+    auto report(llvm::Error error, const char* what) -> void {
+	fprintf(stderr, "error: %s: %s\n", what, llvm::toString(std::move(error)).c_str());
+    }
+
+}
+
+jit_session::jit_session(std::unique_ptr<llvm::orc::LLJIT> jit, bool lazy)
+    : _jit{std::move(jit)}
+    , _lazy{lazy}
+{}
+
+[[nodiscard]] auto jit_session::create(bool lazy, opt_level level) -> std::unique_ptr<jit_session> {
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+
+    auto host = llvm::orc::JITTargetMachineBuilder::detectHost();
+    if(!host) {
+	report(host.takeError(), "unable to detect host");
+	return nullptr;
+    }
+    host->setCodeGenOptLevel(codegen_level(level));
+
+    llvm::Expected<std::unique_ptr<llvm::orc::LLJIT>> jit = lazy
+	? llvm::Expected<std::unique_ptr<llvm::orc::LLJIT>>{llvm::orc::LLLazyJITBuilder{}.setJITTargetMachineBuilder(std::move(*host)).create()}
+	: llvm::orc::LLJITBuilder{}.setJITTargetMachineBuilder(std::move(*host)).create();
+    if(!jit) {
+	report(jit.takeError(), "unable to create JIT");
+	return nullptr;
+    }
+    return std::unique_ptr<jit_session>{new jit_session{std::move(*jit), lazy}};
+}
+
+[[nodiscard]] auto jit_session::add(std::unique_ptr<llvm::Module> module, std::unique_ptr<llvm::LLVMContext> context) -> bool {
+    // signatures are taken before module is handed over, after that it may be compiled and freed at any time
+    for(const auto& function: *module) {
+	if(function.isDeclaration())
+	    continue;
+	std::vector<value_kind> kinds;
+	// language signedness of integers is kept by code generator in extension attributes
+	auto kind = [] (llvm::Type* type, bool zero_extended) -> value_kind {
+	    if(type->isIntegerTy())
+		return {value_kind::integer, type->getIntegerBitWidth(), !zero_extended};
+	    if(type->isFloatTy() || type->isDoubleTy())
+		return {value_kind::floating, static_cast<unsigned>(type->getPrimitiveSizeInBits().getFixedSize()), true};
+	    return {value_kind::none, 0, false};
+	};
+	for(const auto& arg: function.args())
+	    kinds.push_back(kind(arg.getType(), arg.hasZExtAttr()));
+	kinds.push_back(kind(function.getReturnType(), function.hasRetAttribute(llvm::Attribute::ZExt)));
+	_signatures.emplace_back(function.getName().str(), std::move(kinds));
+    }
+
+    auto name = module->getModuleIdentifier();
+    auto tsm = llvm::orc::ThreadSafeModule{std::move(module), std::move(context)};
+    auto error = _lazy
+	? static_cast<llvm::orc::LLLazyJIT&>(*_jit).addLazyIRModule(std::move(tsm))
+	: _jit->addIRModule(std::move(tsm));
+    if(error) {
+	report(std::move(error), "unable to add module to JIT");
+	return false;
+    }
+    TRACE(driver, info, "added %s to JIT", name.c_str());
+    return true;
+}
+
+[[nodiscard]] auto jit_session::run(const std::string& entry, const std::vector<std::string>& args) -> std::optional<std::string> {
+    auto signature = std::find_if(_signatures.begin(), _signatures.end(), [&entry] (const auto& s) { return s.first == entry; });
+    if(signature == _signatures.end()) {
+	fprintf(stderr, "error: entry function \"%s\" is not defined\n", entry.c_str());
+	return std::nullopt;
+    }
+    const auto& kinds = signature->second;
+    if(kinds.size() - 1 != args.size()) {
+	fprintf(stderr, "error: entry function \"%s\" expects %zu arguments, given %zu\n", entry.c_str(), kinds.size() - 1, args.size());
+	return std::nullopt;
+    }
+    for(const auto& k: kinds)
+	if(k.kind == value_kind::integer && k.bits > 64) {
+	    fprintf(stderr, "error: entry function \"%s\" passes integers wider than 64 bits\n", entry.c_str());
+	    return std::nullopt;
+	}
+
+    // every argument and result is passed through 64 bit slot, floating point values as bits of double
+    std::vector<int64_t> slots(args.size());
+    for(std::size_t i = 0; i < args.size(); ++i) {
+	char* end;
+	errno = 0;
+	bool in_range = true;
+	if(kinds[i].kind == value_kind::floating)
+	    slots[i] = std::bit_cast<int64_t>(std::strtod(args[i].c_str(), &end));
+	else if(kinds[i].kind == value_kind::integer && kinds[i].is_signed) {
+	    auto value = std::strtoll(args[i].c_str(), &end, 0);
+	    auto limit = kinds[i].bits < 64 ? int64_t{1} << (kinds[i].bits - 1) : 0;
+	    in_range = kinds[i].bits == 64 || (value >= -limit && value < limit);
+	    slots[i] = value;
+	} else if(kinds[i].kind == value_kind::integer) {
+	    // strtoull accepts negative numbers and wraps them around
+	    auto value = std::strtoull(args[i].c_str(), &end, 0);
+	    in_range = args[i].find('-') == std::string::npos && (kinds[i].bits == 64 || value >> kinds[i].bits == 0);
+	    slots[i] = static_cast<int64_t>(value);
+	} else {
+	    fprintf(stderr, "error: parameter %zu of \"%s\" cannot be passed from command line\n", i, entry.c_str());
+	    return std::nullopt;
+	}
+	if(errno || *end || args[i].empty()) {
+	    fprintf(stderr, "error: invalid argument \"%s\"\n", args[i].c_str());
+	    return std::nullopt;
+	}
+	if(!in_range) {
+	    fprintf(stderr, "error: argument \"%s\" does not fit into %s%u bit parameter\n", args[i].c_str(), kinds[i].is_signed ? "signed " : "unsigned ", kinds[i].bits);
+	    return std::nullopt;
+	}
+    }
+
+    // wrapper with uniform signature converts slots to parameters of entry and its result back
+    auto context = std::make_unique<llvm::LLVMContext>();
+    auto wrapper_name = "__jit_call." + std::to_string(_calls++);
+    auto module = std::make_unique<llvm::Module>(wrapper_name, *context);
+    llvm::IRBuilder<> builder{*context};
+
+    auto type = [&context] (value_kind k) -> llvm::Type* {
+	switch(k.kind) {
+	    case value_kind::integer:  return llvm::Type::getIntNTy(*context, k.bits);
+	    case value_kind::floating: return k.bits == 32 ? llvm::Type::getFloatTy(*context) : llvm::Type::getDoubleTy(*context);
+	    default:                   return llvm::Type::getVoidTy(*context);
+	}
+    };
+    std::vector<llvm::Type*> params;
+    for(std::size_t i = 0; i + 1 < kinds.size(); ++i)
+	params.push_back(type(kinds[i]));
+    auto callee = llvm::Function::Create(llvm::FunctionType::get(type(kinds.back()), params, false), llvm::Function::ExternalLinkage, entry, module.get());
+
+    auto slot_type = builder.getInt64Ty();
+    auto slot_pointer = llvm::PointerType::getUnqual(slot_type);
+    auto wrapper = llvm::Function::Create(llvm::FunctionType::get(builder.getVoidTy(), {slot_pointer, slot_pointer}, false), llvm::Function::ExternalLinkage, wrapper_name, module.get());
+    builder.SetInsertPoint(llvm::BasicBlock::Create(*context, "entry", wrapper));
+
+    std::vector<llvm::Value*> values;
+    for(std::size_t i = 0; i < params.size(); ++i) {
+	llvm::Value* slot = builder.CreateLoad(slot_type, builder.CreateConstGEP1_64(slot_type, wrapper->getArg(0), i));
+	if(kinds[i].kind == value_kind::integer)
+	    slot = builder.CreateTrunc(slot, params[i]);
+	else {
+	    slot = builder.CreateBitCast(slot, builder.getDoubleTy());
+	    slot = builder.CreateFPTrunc(slot, params[i]);
+	}
+	values.push_back(slot);
+    }
+    llvm::Value* result = builder.CreateCall(callee, values);
+    if(kinds.back().kind == value_kind::integer)
+	builder.CreateStore(kinds.back().is_signed ? builder.CreateSExt(result, slot_type) : builder.CreateZExt(result, slot_type), wrapper->getArg(1));
+    else if(kinds.back().kind == value_kind::floating)
+	builder.CreateStore(builder.CreateBitCast(builder.CreateFPExt(result, builder.getDoubleTy()), slot_type), wrapper->getArg(1));
+    builder.CreateRetVoid();
+
+    if(auto error = _jit->addIRModule(llvm::orc::ThreadSafeModule{std::move(module), std::move(context)})) {
+	report(std::move(error), "unable to add entry wrapper to JIT");
+	return std::nullopt;
+    }
+    auto symbol = _jit->lookup(wrapper_name);
+    if(!symbol) {
+	report(symbol.takeError(), "unable to compile entry function");
+	return std::nullopt;
+    }
+
+    int64_t returned = 0;
+    auto call = reinterpret_cast<void(*)(int64_t*, int64_t*)>(symbol->getAddress());
+    call(slots.data(), &returned);
+
+    switch(kinds.back().kind) {
+	case value_kind::integer:
+	    if(kinds.back().bits == 1)
+		return returned ? "true" : "false";
+	    return kinds.back().is_signed ? std::to_string(returned) : std::to_string(static_cast<uint64_t>(returned));
+	case value_kind::floating: {
+	    char text[32];
+	    snprintf(text, sizeof(text), "%.17g", std::bit_cast<double>(returned));
+	    return text;
+	}
+	default:                   return std::string{};
+    }
+}
@@ -1,201 +1,331 @@
 #include <algorithm>
 #include <cstdint>
 #include <cstdio>
+#include <string_view>
+#include <utility>
 
+#include "char_class.hpp"
 #include "lexer.hpp"
+#include "trace.hpp"
 
-std::map<std::string, uint8_t> lexer::_tokens = {
-    {"return", tokens::return_token},
-};
+namespace {
+
+    /**
+     * Key word and its token
+     */
+    struct keyword {
+	std::string_view spelling;
+	tokens token;
+    };
+
+    constexpr std::array<keyword, 2> keywords = {{
+	{"return", tokens::return_token},
+	{"function", tokens::function_token},
+    }};
+
+    /**
+     * Perfect hash of key words: length, first and last character are mixed by multiplier
+     * that is searched for at compile time, so that every key word gets its own slot
+     */
+    namespace keyword_hash {
+
+	constexpr unsigned bits = 3;
+	constexpr std::size_t slots = std::size_t{1} << bits;
+
+	constexpr auto mix(std::string_view word, uint32_t multiplier) noexcept -> std::size_t {
+	    uint32_t key = static_cast<uint32_t>(word.size()) << 16
+			 | static_cast<uint32_t>(static_cast<unsigned char>(word.front())) << 8
+			 | static_cast<unsigned char>(word.back());
+	    return (key * multiplier) >> (32 - bits);
+	}
+
+	constexpr uint32_t multiplier = [] {
+	    for(uint32_t candidate = 1; candidate < 1'000'000; candidate += 2) {
+		std::array<bool, slots> taken{};
+		bool collided = false;
+		for(const auto& k: keywords)
+		    collided = std::exchange(taken[mix(k.spelling, candidate)], true) || collided;
+		if(!collided)
+		    return candidate;
+	    }
+	    return uint32_t{0};
+	}();
+	static_assert(multiplier != 0, "no perfect hash of key words, increase number of slots");
+
+	constexpr std::array<keyword, slots> table = [] {
+	    std::array<keyword, slots> t{};
+	    for(const auto& k: keywords)
+		t[mix(k.spelling, multiplier)] = k;
+	    return t;
+	}();
+
+	/**
+	 * Get token of key word, or tokens::identifier if word is not a key word
+	 * @param word a non-empty identifier
+	 */
+	constexpr auto find(std::string_view word) noexcept -> tokens {
+	    const keyword& candidate = table[mix(word, multiplier)];
+	    return candidate.spelling == word ? candidate.token : tokens::identifier;
+	}
+
+    }
+
+    // special symbols that cannot be overriden
+    constexpr std::array<tokens, 256> punctuation_tokens = [] {
+	std::array<tokens, 256> table{};
+	table['('] = tokens::left_parenthesis;
+	table[')'] = tokens::right_parenthesis;
+	table['['] = tokens::left_square_bracket;
+	table[']'] = tokens::right_square_bracket;
+	table['{'] = tokens::left_curly_brace;
+	table['}'] = tokens::right_curly_brace;
+	table[','] = tokens::comma;
+	table['.'] = tokens::dot;
+	return table;
+    }();
+
+}
 
 lexer::lexer(std::string_view filename) 
-    : _file{std::fopen(filename.data(), "r"), std::fclose}
+    : lexer{source_buffer{filename}}
+{}
+
+lexer::lexer()
+    : lexer{source_buffer{}}
+{}
+
+lexer::lexer(const lexer& other, std::size_t offset)
+    : _source{llvm::MemoryBuffer::getMemBuffer(llvm::StringRef{other._source.text().data(), other._source.size()}, other._source.name())}
+    , _cursor{_source.begin() + offset}
+    , _end{_source.end()}
+    , _last{_cursor != _end ? *_cursor : static_cast<char>(EOF)}
 {
-    if(!_file)
-	throw std::runtime_error("Unable to read from file");
     consume();
 }
 
-[[nodiscard]] auto lexer::token() noexcept -> uint8_t {
+lexer::lexer(source_buffer&& source)
+    : _source{std::move(source)}
+    , _cursor{_source.begin()}
+    , _end{_source.end()}
+    , _last{_cursor != _end ? *_cursor : static_cast<char>(EOF)}
+{
+    consume();
+}
+
+[[nodiscard]] auto lexer::token() const noexcept -> tokens {
     return _current_token;
 }
 
-[[nodiscard]] auto lexer::identifier() noexcept -> std::string& {
-    return _identifier;
+[[nodiscard]] auto lexer::identifier() const noexcept -> std::string_view {
+    return text(_span);
+}
+
+[[nodiscard]] auto lexer::interned() const noexcept -> symbol {
+    return _symbol;
+}
+
+[[nodiscard]] auto lexer::span() const noexcept -> source_span {
+    return _span;
+}
+
+[[nodiscard]] auto lexer::text(source_span span) const noexcept -> std::string_view {
+    return {_source.begin() + span.offset, span.length};
 }
 
 auto lexer::consume() noexcept -> void {
     _current_token = read_token();
+    ++_consumed;
+    TRACE(lexer, debug, "token %d \"%.*s\" at %u", static_cast<int>(_current_token), static_cast<int>(_span.length), _source.begin() + _span.offset, _span.offset);
+}
+
+[[nodiscard]] auto lexer::token_count() const noexcept -> std::size_t {
+    return _consumed;
+}
+
+[[nodiscard]] auto lexer::size() const noexcept -> std::size_t {
+    return static_cast<std::size_t>(_end - _source.begin());
+}
+
+[[nodiscard]] auto lexer::position() const noexcept -> std::size_t {
+    return static_cast<std::size_t>(_cursor - _source.begin());
 }
 
-[[nodiscard]] auto lexer::read_token() noexcept -> uint8_t {
-    static char last = ' ';
-    _identifier = {};
+[[nodiscard]] auto lexer::read_token() noexcept -> tokens {
+    set_span(_cursor, _cursor);
+    _symbol = {};
 
     // skip spaces and emit End Of Line tokens
-    if(iseol(last)) {
-	last = read_char();
+    if(iseol(_last)) {
+	_last = read_char();
 	return tokens::eol;
     }
-    while(isspace(last)) {
-	last = read_char();
-	if(last == '\n' || last == '\r')
+    if(has_class(_last, char_class::blank)) {
+	_last = seek(_scanner->skip_blanks(_cursor + 1, _end));
+	if(iseol(_last))
 	    return tokens::eol;
     }
 
-    // special symbols that cannot be overriden
-    static const std::map<char, uint8_t> special_non_overridable {
-	{'(', tokens::left_parenthesis},
-	{')', tokens::right_parenthesis},
-	{'[', tokens::left_square_bracket},
-	{']', tokens::right_square_bracket},
-	{'{', tokens::left_curly_brace},
-	{'}', tokens::right_curly_brace},
-	{',', tokens::comma},
-	{'.', tokens::dot},
-    };
-    if(last != '.' && special_non_overridable.contains(last) ||
-       last == '.' && !isdigit(peek())) {
-	_identifier = last;
-	uint8_t token = special_non_overridable.at(last);
-	last = read_char();
+    const char* begin = _cursor;
+    set_span(begin, begin);
+
+    // special symbols that cannot be overriden, '.' followed by digit starts a number
+    if(has_class(_last, char_class::punctuation) &&
+       (_last != '.' || !has_class(peek(), char_class::digit))) {
+	tokens token = punctuation_tokens[static_cast<unsigned char>(_last)];
+	_last = read_char();
+	set_span(begin, _cursor);
 	return token;
     }
 
     // special symbols that serve as operators
-    if(!iscomment(last, peek()) && isspecial(last)) {
-	_identifier.push_back(last);
-	while(isspecial(last = read_char()))
-	    _identifier.push_back(last);
+    if(!iscomment(_last, peek()) && isspecial(_last)) {
+	while(isspecial(_last = read_char()));
+	set_span(begin, _cursor);
+	_symbol = interner::intern(identifier());
 	return tokens::identifier;
     }
 
     // identifier [a-zA-Z_][a-zA-Z0-9_]*
-    if(isalpha(last) || last == '_') {
-	_identifier.push_back(last);
-	while(std::isalnum(last = read_char()) || last == '_')
-	    _identifier.push_back(last);
+    if(has_class(_last, char_class::alpha)) {
+	_last = seek(_scanner->skip_identifier(_cursor + 1, _end));
+	set_span(begin, _cursor);
 
-	auto token_id = _tokens[_identifier];
-	return token_id ? token_id : tokens::identifier;
+	if(auto token = keyword_hash::find(identifier()); token != tokens::identifier)
+	    return token;
+	_symbol = interner::intern(identifier());
+	return tokens::identifier;
     }
 
     // character literals
-    if(last == '\'') {
-	_identifier.push_back(read_char());
-	last = read_char();
-	if(last != '\'')
+    if(_last == '\'') {
+	_last = read_char();
+	begin = _cursor;
+	_last = read_char();
+	set_span(begin, _cursor);
+	if(_last != '\'')
 	    return tokens::error;
-	last = read_char();
+	_last = read_char();
 	return tokens::character;
     }
 
     // string literals
-    if(last == '\"') {
-	while((last = read_char()) != '\"' && last != EOF)
-	    _identifier.push_back(last);
-	if(last == EOF)
+    if(_last == '\"') {
+	begin = _cursor + 1;
+	while((_last = read_char()) != '\"' && _last != EOF);
+	set_span(begin, _cursor);
+	if(_last == EOF)
 	    return tokens::error;
-	last = read_char();
+	_last = read_char();
 	return tokens::string;
     }
 
     // number (0x|0b|.|[0-9])[0-9._]*
-    if(isfloatingdigit(last)) {
-	uint8_t number_type;
+    if(isfloatingdigit(_last)) {
+	tokens number_type;
 	bool (*validator)(char);
 
 	// handle types of numbers
-	if(ishexadecimalprefix(last, peek())) {   // found "0x" - hexadecimal number
-	    last = read_char(); // eat 'x'
-	    last = read_char();
+	if(ishexadecimalprefix(_last, peek())) {   // found "0x" - hexadecimal number
+	    _last = read_char(); // eat 'x'
+	    _last = read_char();
 	    number_type = tokens::hexadecimal;
 	    validator = ishexadecimaldigit;
-	} else if(isoctalprefix(last, peek())) {  // found '0' and number in range 0-7 - octal number
-	    last = read_char();
+	} else if(isoctalprefix(_last, peek())) {  // found '0' and number in range 0-7 - octal number
+	    _last = read_char();
 	    number_type = tokens::octal;
 	    validator = isoctaldigit;
-	} else if(isbinaryprefix(last, peek())) { // found "0b" - binary number
-	    last = read_char(); // eat 'b'
-	    last = read_char();
+	} else if(isbinaryprefix(_last, peek())) { // found "0b" - binary number
+	    _last = read_char(); // eat 'b'
+	    _last = read_char();
 	    number_type = tokens::binary;
 	    validator = isbinarydigit;
-	} else if(last == '0') {                  // found '0' and some other number or character that is not prefix of a number type - decimal '0'
-	    _identifier.push_back(last);
-	    last = read_char();
+	} else if(_last == '0') {                  // found '0' and some other number or character that is not prefix of a number type - decimal '0'
+	    _last = read_char();
+	    set_span(begin, _cursor);
 	    return tokens::decimal;
-	} else if(last == '.') {                  // found '.' - floating point number
+	} else if(_last == '.') {                  // found '.' - floating point number
 	    number_type = tokens::floating;
 	    validator = isfloatingdigit;
-	} else {                                  // found number in range 0-9 - decimal
+	} else {                                   // found number in range 0-9 - decimal
 	    number_type = tokens::decimal;
 	    validator = isdecimaldigit;
 	}
 
-	// read characters until validator is false
+	// read characters until validator is false, runs of decimal digits are skipped at once
+	begin = _cursor;
 	do {
-	    _identifier.push_back(last);
-	    last = read_char();
-	    if(last == '_') // skip '_'
+	    if(number_type == tokens::decimal || number_type == tokens::floating)
+		_last = seek(_scanner->skip_digits(_cursor + 1, _end));
+	    else
+		_last = read_char();
+	    if(_last == '_') // skip '_'
 		continue;
-	    if(last == '.' && number_type == tokens::decimal) { // found first '.' in decimal - fall back to floating point
+	    if(_last == '.' && number_type == tokens::decimal) { // found first '.' in decimal - fall back to floating point
 		number_type = tokens::floating;
 		validator = isfloatingdigit;
-	    } else if(last == '.')                              // found '.' in hexadecimal, octal or floating point - return with error
+	    } else if(_last == '.') {                            // found '.' in hexadecimal, octal or floating point - return with error
+		set_span(begin, _cursor);
 		return tokens::error;
-	} while(validator(last));
+	    }
+	} while(validator(_last));
+	set_span(begin, _cursor);
 
-	if(isfloatingdigit(last) || ishexadecimaldigit(last)) // found digit right after another digit without separation 
+	if(isfloatingdigit(_last) || ishexadecimaldigit(_last)) // found digit right after another digit without separation 
 	    return tokens::error;
 
 	return number_type;
     }
 
     // skip comment // and /* ... */
-    if(iscomment(last, peek())) {
+    if(iscomment(_last, peek())) {
 	char next = read_char();
-	if(issinglelinecomment(last, next)) {
+	if(issinglelinecomment(_last, next))
+	    _last = seek(_scanner->find_eol(_cursor + 1, _end));
+	if(ismultilinecomment(_last, next)) {
+	    const char* star = _cursor;
 	    do
-		last = read_char();
-	    while(last != '\n' && last != '\r' && last != EOF);
-	}
-	if(ismultilinecomment(last, next)) {
-	    char prev;
-	    do {
-		prev = last;
-		last = read_char();
-	    } while(!(prev == '*' && last == '/') && last != EOF);
+		star = _scanner->find_star(star + 1, _end);
+	    while(star != _end && (star + 1 == _end || star[1] != '/'));
+	    _last = seek(star != _end ? star + 1 : _end);
 	}
 
-	last = read_char();
-	if(last == EOF)
+	_last = read_char();
+	if(_last == EOF)
 	    return tokens::eof;
 	return read_token();
     }
 
-    if(last == EOF)
+    if(_last == EOF)
 	return tokens::eof;
 
     return tokens::error;
 }
 
 [[nodiscard]] auto lexer::read_char() noexcept -> char {
-    return std::fgetc(_file.get());
+    if(_cursor != _end)
+	++_cursor;
+    return _cursor != _end ? *_cursor : EOF;
+}
+
+[[nodiscard]] auto lexer::seek(const char* position) noexcept -> char {
+    _cursor = position;
+    return _cursor != _end ? *_cursor : EOF;
 }
 
 [[nodiscard]] auto lexer::peek() noexcept -> char {
-    char last = std::fgetc(_file.get());
-    std::ungetc(last, _file.get());
-    return last;
+    return _cursor != _end && _cursor + 1 != _end ? _cursor[1] : EOF;
+}
+
+auto lexer::set_span(const char* begin, const char* end) noexcept -> void {
+    _span = {static_cast<uint32_t>(begin - _source.begin()), static_cast<uint32_t>(end - begin)};
 }
 
 [[nodiscard]] constexpr auto isspecial(char ch) noexcept -> bool {
-    constexpr std::array SPECIAL_SYMBOL_TOKENS{'!', '#', '$', '%', '&', '*', '+', '-', '/', ':', ';', '<', '=', '>', '?', '@', '^', '~'};
-    return std::ranges::binary_search(SPECIAL_SYMBOL_TOKENS, ch);
+    return has_class(ch, char_class::special);
 }
 
 [[nodiscard]] constexpr auto iseol(char ch) noexcept -> bool {
-    return ch == '\n' || ch == '\r';
+    return has_class(ch, char_class::eol);
 }
 
 [[nodiscard]] constexpr auto iscomment(char first, char second) noexcept -> bool {
@@ -219,14 +349,11 @@ auto lexer::consume() noexcept -> void {
 }
 
 [[nodiscard]] constexpr auto isdecimaldigit(char ch) noexcept -> bool {
-    return ch >= '0' && ch <= '9' || ch == '_';
+    return has_class(ch, char_class::digit) || ch == '_';
 }
 
 [[nodiscard]] constexpr auto ishexadecimaldigit(char ch) noexcept -> bool {
-    return ch >= '0' && ch <= '9' || 
-	   ch >= 'a' && ch <= 'f' ||
-	   ch >= 'A' && ch <= 'F' ||
-	   ch == '_';
+    return has_class(ch, char_class::digit | char_class::hex_letter) || ch == '_';
 }
 
 [[nodiscard]] constexpr auto isfloatingdigit(char ch) noexcept -> bool {
@@ -1,39 +1,290 @@
+#include <algorithm>
+#include <chrono>
 #include <cstdio>
+#include <optional>
+#include <string>
+#include <vector>
 
-#include "lexer.hpp"
-#include "parser.hpp"
-#include "semantic_analyzer.hpp"
-#include "code_generator.hpp"
+#include <unistd.h>
+
+#include <llvm/ADT/SmallString.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/Support/CommandLine.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Support/ThreadPool.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include "code_target.hpp"
+#include "compilation_cache.hpp"
+#include "compile_server.hpp"
+#include "frontend.hpp"
+#include "global_context.hpp"
+#include "jit_session.hpp"
+#include "optimizer.hpp"
+#include "scanner.hpp"
+#include "time_report.hpp"
+#include "trace.hpp"
+
+namespace {
+
+    /**
+     * Form of compiled module
+     */
+    enum class emit_kind {
+	print,   ///< textual IR printed to standard error
+	ir,      ///< textual IR written to .ll file
+	bitcode, ///< bitcode written to .bc file
+	object,  ///< machine code of target written to .o file
+    };
+
+    llvm::cl::OptionCategory driver_options("Compiler options"); ///< options of driver, the only ones listed by --help
+
+    llvm::cl::list<std::string> input_files(llvm::cl::Positional, llvm::cl::desc("<input files>"), llvm::cl::cat(driver_options), llvm::cl::ZeroOrMore);
+
+    llvm::cl::opt<scan_mode> lexer_scan("lexer-scan", llvm::cl::desc("Instruction set used by lexer to scan runs of characters"), llvm::cl::cat(driver_options),
+	    llvm::cl::values(
+		clEnumValN(scan_mode::scalar, "scalar", "one character at a time, for CPUs without SIMD"),
+		clEnumValN(scan_mode::sse2, "sse2", "16 characters at a time"),
+		clEnumValN(scan_mode::avx2, "avx2", "32 characters at a time")),
+	    llvm::cl::init(scanner::best_mode()));
+
+    llvm::cl::opt<unsigned> jobs("j", llvm::cl::desc("Number of worker threads, 0 means number of hardware threads"), llvm::cl::cat(driver_options), llvm::cl::Prefix, llvm::cl::ValueRequired, llvm::cl::init(0));
+
+    llvm::cl::opt<emit_kind> emit("emit", llvm::cl::desc("Form of compiled modules"), llvm::cl::cat(driver_options),
+	    llvm::cl::values(
+		clEnumValN(emit_kind::print, "print", "print IR of every module to standard error"),
+		clEnumValN(emit_kind::ir, "ll", "write IR of every input to <input>.ll"),
+		clEnumValN(emit_kind::bitcode, "bc", "write bitcode of every input to <input>.bc"),
+		clEnumValN(emit_kind::object, "obj", "write object file of every input to <input>.o")),
+	    llvm::cl::init(emit_kind::print));
+
+    llvm::cl::opt<std::string> mtriple("mtriple", llvm::cl::desc("Target triple of generated code, host by default"), llvm::cl::cat(driver_options), llvm::cl::init(""));
+
+    llvm::cl::opt<std::string> mcpu("mcpu", llvm::cl::desc("Target CPU of generated code, \"native\" for CPU of host"), llvm::cl::cat(driver_options), llvm::cl::value_desc("cpu-name"), llvm::cl::init(""));
+
+    llvm::cl::opt<std::string> mattr("mattr", llvm::cl::desc("Features of target CPU added or removed, e.g. +avx2,-sse4a"), llvm::cl::cat(driver_options), llvm::cl::value_desc("a1,+a2,-a3,..."), llvm::cl::init(""));
+
+    llvm::cl::list<trace::category> trace_categories("trace", llvm::cl::desc("Print trace of compiler stages, requires build with COMPILER_TRACE"), llvm::cl::cat(driver_options),
+	    llvm::cl::CommaSeparated,
+	    llvm::cl::values(
+		clEnumValN(trace::category::lexer, "lexer", "every token"),
+		clEnumValN(trace::category::parser, "parser", "parsing routines"),
+		clEnumValN(trace::category::sema, "sema", "semantic analysis of AST nodes"),
+		clEnumValN(trace::category::codegen, "codegen", "code generation of AST nodes"),
+		clEnumValN(trace::category::driver, "driver", "stages of every compiled file")));
+
+    llvm::cl::opt<opt_level> opt("O", llvm::cl::desc("Optimization level of generated modules"), llvm::cl::cat(driver_options), llvm::cl::Prefix,
+	    llvm::cl::values(
+		clEnumValN(opt_level::O0, "0", "no optimization (default)"),
+		clEnumValN(opt_level::O1, "1", "fast optimizations"),
+		clEnumValN(opt_level::O2, "2", "most optimizations"),
+		clEnumValN(opt_level::O3, "3", "all optimizations")),
+	    llvm::cl::init(opt_level::O0));
+
+    llvm::cl::opt<bool> function_passes("function-passes", llvm::cl::desc("Run fast function pipeline on every function right after it is generated, on worker threads"), llvm::cl::cat(driver_options), llvm::cl::init(false));
+
+    llvm::cl::opt<trace::level> trace_level("trace-level", llvm::cl::desc("Verbosity of trace"), llvm::cl::cat(driver_options),
+	    llvm::cl::values(
+		clEnumValN(trace::level::info, "info", "milestones of compilation"),
+		clEnumValN(trace::level::debug, "debug", "every token and AST node")),
+	    llvm::cl::init(trace::level::debug));
+
+    llvm::cl::opt<time_report::format> report("time-report", llvm::cl::desc("Print time of every compilation phase, counters and peak memory to standard error"), llvm::cl::cat(driver_options),
+	    llvm::cl::ValueOptional,
+	    llvm::cl::values(
+		clEnumValN(time_report::format::table, "", "human readable table, same as =table"),
+		clEnumValN(time_report::format::table, "table", "human readable table"),
+		clEnumValN(time_report::format::json, "json", "one JSON object")));
+
+    llvm::cl::opt<bool> serve("serve", llvm::cl::desc("Compile JSON line requests from standard input, or from -socket, until shutdown"), llvm::cl::cat(driver_options), llvm::cl::init(false));
+
+    llvm::cl::opt<std::string> socket_path("socket", llvm::cl::desc("Unix domain socket that -serve listens on"), llvm::cl::cat(driver_options), llvm::cl::value_desc("path"), llvm::cl::init(""));
+
+    llvm::cl::opt<std::string> cache_dir("cache-dir", llvm::cl::desc("Directory of compilation cache, compiled modules are reused if source, operators and compiler did not change"), llvm::cl::cat(driver_options), llvm::cl::value_desc("path"), llvm::cl::init(""));
+
+    llvm::cl::opt<uint64_t> cache_size("cache-size", llvm::cl::desc("Maximum size of compilation cache in megabytes, least recently used modules are evicted"), llvm::cl::cat(driver_options), llvm::cl::init(512));
+
+    llvm::cl::opt<bool> cache_stats("cache-stats", llvm::cl::desc("Print hits and misses of compilation cache"), llvm::cl::cat(driver_options), llvm::cl::init(false));
+
+    llvm::cl::opt<bool> jit("jit", llvm::cl::desc("Compile inputs to native code in memory and call entry function instead of emitting modules"), llvm::cl::cat(driver_options), llvm::cl::init(false));
+
+    llvm::cl::opt<bool> jit_lazy("jit-lazy", llvm::cl::desc("Compile every function when it is called first"), llvm::cl::cat(driver_options), llvm::cl::init(true));
+
+    llvm::cl::opt<std::string> entry("entry", llvm::cl::desc("Function called by -jit"), llvm::cl::cat(driver_options), llvm::cl::init("main"));
+
+    llvm::cl::list<std::string> entry_args("args", llvm::cl::desc("Arguments of entry function called by -jit"), llvm::cl::cat(driver_options), llvm::cl::CommaSeparated);
+
+    llvm::cl::opt<std::string> output_dir("output-dir", llvm::cl::desc("Directory for output files, by default they are placed next to inputs"), llvm::cl::cat(driver_options), llvm::cl::init(""));
+
+    /**
+     * Get path of output file for input, standard input is written to standard output
+     */
+    auto output_path(const std::string& input) -> std::string {
+	if(input == "-")
+	    return "-";
+
+	llvm::SmallString<128> path{input};
+	llvm::sys::path::replace_extension(path, emit == emit_kind::bitcode ? "bc" : emit == emit_kind::object ? "o" : "ll");
+	if(!output_dir.empty()) {
+	    llvm::SmallString<128> in_dir{output_dir.getValue()};
+	    llvm::sys::path::append(in_dir, llvm::sys::path::filename(path));
+	    path = in_dir;
+	}
+	return std::string{path};
+    }
+
+    /**
+     * Compile one input file and emit its module
+     * @param input a path to input file, "-" for standard input
+     * @param compiler a frontend that compiles input
+     * @param printed an output for emit_kind::print, printed after all inputs are compiled
+     * @param target a target of emit_kind::object
+     * @return true if file was compiled
+     */
+    auto compile_file(const std::string& input, const frontend& compiler, std::string& printed, const code_target* target) -> bool {
+	std::string module_name = input != "-" ? input : "test_module";
+
+	auto module = compiler.compile_file(input, module_name, global_context::context());
+	if(!module)
+	    return false;
+
+	auto timer = time_report::scope{time_report::phase::emit};
+	if(emit == emit_kind::print) {
+	    llvm::raw_string_ostream stream{printed};
+	    module->print(stream, nullptr);
+	    return true;
+	}
+
+	std::error_code error;
+	auto path = output_path(input);
+	llvm::raw_fd_ostream stream{path, error, emit == emit_kind::ir ? llvm::sys::fs::OF_Text : llvm::sys::fs::OF_None};
+	if(error) {
+	    fprintf(stderr, "error: unable to open \"%s\": %s\n", path.c_str(), error.message().c_str());
+	    return false;
+	}
+	if(emit == emit_kind::object)
+	    return target->emit_object(*module, stream);
+	if(emit == emit_kind::bitcode)
+	    llvm::WriteBitcodeToFile(*module, stream);
+	else
+	    module->print(stream, nullptr);
+	return true;
+    }
+
+    /**
+     * Compile all inputs into one JIT session and call entry function
+     * @return true if entry function was called
+     */
+    auto run_jit(const std::vector<std::string>& inputs, const frontend& compiler) -> bool {
+	auto session = jit_session::create(jit_lazy, opt);
+	if(!session)
+	    return false;
+
+	// every module gets its own context, JIT owns both and may compile them on any thread
+	bool compiled = true;
+	for(const auto& input: inputs) {
+	    auto context = std::make_unique<llvm::LLVMContext>();
+	    auto module = compiler.compile_file(input, input != "-" ? input : "test_module", *context);
+	    compiled = module && session->add(std::move(module), std::move(context)) && compiled;
+	}
+	if(!compiled)
+	    return false;
+
+	auto result = session->run(entry, {entry_args.begin(), entry_args.end()});
+	if(!result)
+	    return false;
+	if(!result->empty())
+	    printf("%s\n", result->c_str());
+	return true;
+    }
+
+    /**
+     * Print time report and statistics of cache if they were requested
+     * @param start a time when compilation started
+     * @param cache a compilation cache, if it was used
+     */
+    auto print_statistics(std::chrono::steady_clock::time_point start, const std::optional<compilation_cache>& cache) -> void {
+	if(cache && cache_stats)
+	    cache->print_statistics(llvm::errs());
+	if(!time_report::enabled())
+	    return;
+	auto wall = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+	time_report::print(llvm::errs(), report, wall.count());
+    }
+
+}
 
 int main(int argc, char** argv) {
-    lexer l;
-    std::string module_name = "test_module";
-    if(argc == 2) {
-	l = lexer{argv[1]};
-	module_name = argv[1];
-    }
-
-    auto t = operator_table{};
-    t["="] = 0;
-    t["+"] = 2;
-    t["-"] = 2;
-    t["*"] = 3;
-    t["/"] = 3;
-
-    auto p = parser(std::move(l), std::move(t));
-    auto sa = semantic_analyzer{};
-    auto cg = code_generator(module_name);
-    if(auto fe = p.parse_function()) {
-	fprintf(stdout, "parsed a function\n");
-	if(!fe->accept(&sa)) {
+    // linked LLVM libraries register hundreds of internal options, they are hidden from --help
+    llvm::cl::HideUnrelatedOptions(driver_options);
+    llvm::cl::ParseCommandLineOptions(argc, argv, "compiler frontend\n");
+    scanner::select(lexer_scan);
+    if(report.getNumOccurrences())
+	time_report::enable();
+    auto start = std::chrono::steady_clock::now();
+    for(auto category: trace_categories)
+	trace::enable(category, trace_level);
+
+    std::optional<compilation_cache> cache;
+    if(!cache_dir.empty())
+	cache.emplace(cache_dir, cache_size * 1024 * 1024);
+    compilation_cache* shared_cache = cache ? &*cache : nullptr;
+    auto settings = optimization{opt, function_passes};
+
+    // modules get triple and data layout only if machine code is generated or target is chosen explicitly, JIT always targets host
+    std::unique_ptr<code_target> target;
+    if(!jit && (emit == emit_kind::object || serve || mtriple.getNumOccurrences() || mcpu.getNumOccurrences() || mattr.getNumOccurrences())) {
+	target = code_target::create(mtriple, mcpu, mattr, opt);
+	if(!target)
 	    return -1;
+    }
+
+    if(serve) {
+	bool served = true;
+	if(socket_path.empty()) {
+	    auto compiler = frontend{jobs, shared_cache, settings, target.get()};
+	    compile_server{compiler, target.get()}.serve(STDIN_FILENO, STDOUT_FILENO);
+	} else {
+	    auto compiler = frontend{1, shared_cache, settings, target.get()};
+	    served = compile_server{compiler, target.get()}.listen(socket_path, jobs);
 	}
-	fprintf(stderr, "finished semantic analysis\n");
-	if(auto *fir = fe->accept(&cg)) {
-	    fprintf(stderr, "read function definition\n");
-	    fir->print(llvm::errs());
-	}
+	print_statistics(start, cache);
+	return served ? 0 : -1;
     }
-    fprintf(stderr, "\n");
-    return 0;
+
+    std::vector<std::string> inputs{input_files.begin(), input_files.end()};
+    if(inputs.empty())
+	inputs.emplace_back("-");
+
+    if(jit) {
+	bool ran = run_jit(inputs, frontend{jobs, shared_cache, settings});
+	print_statistics(start, cache);
+	return ran ? 0 : -1;
+    }
+
+    // one input uses all threads for its functions, several inputs are compiled one per thread
+    std::vector<std::string> printed(inputs.size());
+    std::vector<char> compiled(inputs.size());
+    if(inputs.size() == 1)
+	compiled[0] = compile_file(inputs[0], frontend{jobs, shared_cache, settings, target.get()}, printed[0], target.get());
+    else {
+	auto compiler = frontend{1, shared_cache, settings, target.get()};
+	llvm::ThreadPool pool{llvm::hardware_concurrency(jobs)};
+	for(std::size_t i = 0; i < inputs.size(); ++i)
+	    pool.async([&inputs, &compiler, &printed, &compiled, &target, i] {
+		compiled[i] = compile_file(inputs[i], compiler, printed[i], target.get());
+	    });
+	pool.wait();
+    }
+
+    if(emit == emit_kind::print) {
+	for(const auto& output: printed)
+	    llvm::errs() << output;
+	fprintf(stderr, "\n");
+    }
+
+    print_statistics(start, cache);
+
+    return std::ranges::all_of(compiled, [] (char c) { return c; }) ? 0 : -1;
 }
@@ -0,0 +1,229 @@
+#include <algorithm>
+#include <cstdio>
+
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/Linker/Linker.h>
+#include <llvm/Support/Error.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/ThreadPool.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include "code_generator.hpp"
+#include "global_context.hpp"
+#include "module_compiler.hpp"
+#include "semantic_analyzer.hpp"
+#include "time_report.hpp"
+#include "trace.hpp"
+
+module_compiler::module_compiler(std::string name, unsigned threads, compilation_cache* cache, std::string configuration, bool optimize_functions)
+    : _name{std::move(name)}
+    , _threads{threads}
+    , _cache{cache}
+    , _configuration{std::move(configuration)}
+    , _optimize_functions{optimize_functions}
+{}
+
+[[nodiscard]] auto module_compiler::compile(ast::function_list& functions, llvm::LLVMContext& context) -> std::unique_ptr<llvm::Module> {
+    if(auto timer = time_report::scope{time_report::phase::sema}; !collect_signatures(functions))
+	return nullptr;
+    TRACE(driver, info, "collected signatures of %zu functions", functions.size());
+
+    // functions found in cache are linked as they are, the rest is compiled
+    std::vector<std::string> keys(functions.size());
+    std::vector<std::unique_ptr<llvm::MemoryBuffer>> cached(functions.size());
+    std::vector<std::size_t> pending;
+    for(std::size_t i = 0; i < functions.size(); ++i) {
+	if(_cache && !(keys[i] = function_key(*functions[i])).empty())
+	    cached[i] = _cache->lookup(keys[i]);
+	if(!cached[i])
+	    pending.push_back(i);
+    }
+    TRACE(driver, info, "compiling %zu of %zu functions", pending.size(), functions.size());
+
+    auto strategy = llvm::hardware_concurrency(_threads);
+    auto workers = std::max<std::size_t>(1, std::min<std::size_t>(strategy.compute_thread_count(), pending.size()));
+
+    std::atomic<std::size_t> next{0};
+    std::vector<std::optional<pieces>> results(workers);
+    while(_arenas.size() < workers)
+	_arenas.push_back(std::make_unique<ast::arena>());
+
+    // one worker runs on calling thread and generates in destination context, without cache nothing has to be linked
+    std::unique_ptr<llvm::Module> direct;
+    if(workers == 1)
+	results[0] = compile_functions(functions, pending, next, *_arenas[0], keys, context, _cache ? nullptr : &direct);
+    else {
+	llvm::ThreadPool pool{llvm::hardware_concurrency(static_cast<unsigned>(workers))};
+	for(std::size_t i = 0; i < workers; ++i)
+	    pool.async([this, &functions, &pending, &next, &results, &keys, i] {
+		results[i] = compile_functions(functions, pending, next, *_arenas[i], keys, global_context::context(), nullptr);
+	    });
+	pool.wait();
+    }
+
+    if(std::ranges::any_of(results, [] (const auto& result) { return !result; }))
+	return nullptr;
+    TRACE(driver, info, "finished semantic analysis and code generation");
+    for(const auto& arena: _arenas) {
+	time_report::count(time_report::counter::ast_nodes, arena->node_count());
+	time_report::count(time_report::counter::ast_bytes, arena->node_bytes());
+    }
+    if(direct) {
+	restore_order(functions, *direct);
+	return direct;
+    }
+
+    auto timer = time_report::scope{time_report::phase::link};
+    return link(functions, results, cached, context);
+}
+
+[[nodiscard]] auto module_compiler::collect_signatures(const ast::function_list& functions) -> bool {
+    for(const auto& function: functions) {
+	types::function_type* type = global_context::type(function->types(), function->return_type());
+	if(!type) {
+	    auto name = interner::spelling(function->name());
+	    fprintf(stderr, "error: unknown type in signature of function \"%.*s\"", static_cast<int>(name.size()), name.data());
+	    return false;
+	}
+
+	if(function->name() == symbol{})
+	    continue;
+	if(!_signatures.try_emplace(function->name(), type).second) {
+	    auto name = interner::spelling(function->name());
+	    fprintf(stderr, "error: redefinition of function \"%.*s\"", static_cast<int>(name.size()), name.data());
+	    return false;
+	}
+    }
+    return true;
+}
+
+[[nodiscard]] auto module_compiler::function_key(const ast::function_expression& function) const -> std::string {
+    if(function.name() == symbol{})
+	return {};
+
+    // tokens fix the body and own signature, types of callees fix casts and calls generated in body
+    std::string description = std::to_string(function.fingerprint());
+    for(auto callee: function.callees()) {
+	auto found = _signatures.find(callee);
+	if(found == _signatures.end())
+	    return {}; // call of unknown function fails to compile, nothing to cache
+	description += ' ';
+	description += interner::spelling(callee);
+	description += '(';
+	for(types::type* param: *found->second)
+	    description += param->name() + ',';
+	description += ')';
+	description += found->second->get_return_type()->name();
+    }
+    return compilation_cache::function_key(_configuration, description);
+}
+
+[[nodiscard]] auto module_compiler::compile_functions(ast::function_list& functions, const std::vector<std::size_t>& pending, std::atomic<std::size_t>& next, ast::arena& arena, const std::vector<std::string>& keys, llvm::LLVMContext& context, std::unique_ptr<llvm::Module>* direct) -> std::optional<pieces> {
+    auto sa = semantic_analyzer{arena};
+    for(const auto& [name, type]: _signatures)
+	sa.declare_function(name, type);
+
+    auto write = [] (const llvm::Module& module) {
+	bitcode buffer;
+	llvm::raw_svector_ostream stream{buffer};
+	llvm::WriteBitcodeToFile(module, stream);
+	return buffer;
+    };
+
+    // building pipeline takes longer than optimizing small function, so worker builds it once for all its functions
+    std::optional<optimizer> function_optimizer;
+    if(_optimize_functions)
+	function_optimizer.emplace();
+    optimizer* opt = function_optimizer ? &*function_optimizer : nullptr;
+
+    // without cache all functions of worker share one module, with cache every function is a piece of its own
+    std::optional<code_generator> shared;
+    if(!_cache) {
+	shared.emplace(_name, opt, context);
+	for(const auto& [name, type]: _signatures)
+	    shared->declare_function(name, type);
+    }
+
+    // keep going after failure, so that errors of all functions are reported
+    pieces result;
+    bool succeeded = true;
+    for(std::size_t i = next++; i < pending.size(); i = next++) {
+	auto& function = functions[pending[i]];
+	bool analysed;
+	{
+	    auto timer = time_report::scope{time_report::phase::sema};
+	    analysed = function->accept(&sa);
+	}
+	auto timer = time_report::scope{time_report::phase::codegen};
+	if(shared) {
+	    succeeded = analysed && function->accept(&*shared) && succeeded;
+	    continue;
+	}
+
+	auto cg = code_generator{_name, opt, context};
+	flat_hash_map<symbol, bool> declared;
+	if(function->name() != symbol{})
+	    declared[function->name()] = true;
+	for(auto callee: function->callees())
+	    declared[callee] = true;
+	for(const auto& [name, is_declared]: declared)
+	    if(auto found = _signatures.find(name); found != _signatures.end())
+		cg.declare_function(name, found->second);
+
+	if(!analysed || !function->accept(&cg)) {
+	    succeeded = false;
+	    continue;
+	}
+	result.push_back(write(cg.get_module()));
+	if(!keys[pending[i]].empty())
+	    _cache->store(keys[pending[i]], llvm::StringRef{result.back().data(), result.back().size()});
+    }
+
+    if(!succeeded)
+	return std::nullopt;
+    if(shared && direct)
+	*direct = shared->release_module();
+    else if(shared)
+	result.push_back(write(shared->get_module()));
+    return result;
+}
+
+[[nodiscard]] auto module_compiler::link(const ast::function_list& functions, std::vector<std::optional<pieces>>& results, std::vector<std::unique_ptr<llvm::MemoryBuffer>>& cached, llvm::LLVMContext& context) -> std::unique_ptr<llvm::Module> {
+    auto module = std::make_unique<llvm::Module>(_name, context);
+    llvm::Linker linker{*module}; // one linker for all pieces, constructing it scans whole destination
+
+    auto link_piece = [&linker, &context] (llvm::MemoryBufferRef buffer) {
+	auto parsed = llvm::parseBitcodeFile(buffer, context);
+	if(!parsed) {
+	    fprintf(stderr, "error: unable to read generated bitcode: %s", llvm::toString(parsed.takeError()).c_str());
+	    return false;
+	}
+	if(linker.linkInModule(std::move(*parsed))) {
+	    fprintf(stderr, "error: unable to link generated functions");
+	    return false;
+	}
+	return true;
+    };
+
+    for(auto& result: results) {
+	for(const auto& piece: *result)
+	    if(!link_piece(llvm::MemoryBufferRef{llvm::StringRef{piece.data(), piece.size()}, _name}))
+		return nullptr;
+	result.reset();
+    }
+    for(auto& buffer: cached)
+	if(buffer && !link_piece(buffer->getMemBufferRef()))
+	    return nullptr;
+
+    restore_order(functions, *module);
+    return module;
+}
+
+auto module_compiler::restore_order(const ast::function_list& functions, llvm::Module& module) -> void {
+    // order of linking depends on scheduling of workers and functions are declared in order of signature table, restore order of definition
+    auto& list = module.getFunctionList();
+    for(const auto& function: functions)
+	if(auto defined = module.getFunction(interner::spelling(function->name())))
+	    list.splice(list.end(), list, defined->getIterator());
+}
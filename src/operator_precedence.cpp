@@ -0,0 +1,38 @@
+#include <algorithm>
+#include <bit>
+
+#include "operator_precedence.hpp"
+#include "trace.hpp"
+
+namespace {
+
+    constexpr unsigned min_bits = 3;        ///< tables have at least 8 slots
+    constexpr unsigned attempts = 64;       ///< multipliers tried before table is doubled
+
+}
+
+operator_precedence::operator_precedence(const operator_table& operators) {
+    // at most half of slots are used, so a collision-free multiplier is usually among the first few;
+    // with 32 bits multiplication by odd number is a bijection, so the search always ends
+    unsigned bits = std::max<unsigned>(min_bits, std::bit_width(2 * operators.size()));
+    for(;; ++bits) {
+	_shift = 32 - bits;
+	_multiplier = 0x9e3779b1; // golden ratio
+	for(unsigned attempt = 0; attempt < attempts; ++attempt, _multiplier = (_multiplier * 0x2c9277b5 + 0xac564b06) | 1) {
+	    _slots.assign(std::size_t{1} << bits, slot{});
+	    std::vector<bool> used(_slots.size());
+	    bool collided = std::ranges::any_of(operators, [&] (const auto& entry) {
+		auto i = index(entry.first, _multiplier, _shift);
+		if(used[i])
+		    return true;
+		used[i] = true;
+		_slots[i] = slot{entry.first, entry.second};
+		return false;
+	    });
+	    if(!collided) {
+		TRACE(parser, debug, "operator table of %zu operators compiled into %zu slots after %u attempts", operators.size(), _slots.size(), attempt + 1);
+		return;
+	    }
+	}
+    }
+}
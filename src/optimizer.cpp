@@ -0,0 +1,59 @@
+#include "optimizer.hpp"
+
+namespace {
+
+    auto pass_level(opt_level level) -> llvm::OptimizationLevel {
+	switch(level) {
+	    case opt_level::O0: return llvm::OptimizationLevel::O0;
+	    case opt_level::O1: return llvm::OptimizationLevel::O1;
+	    case opt_level::O2: return llvm::OptimizationLevel::O2;
+	    case opt_level::O3: return llvm::OptimizationLevel::O3;
+	}
+	return llvm::OptimizationLevel::O0;
+    }
+
+}
+
+[[nodiscard]] auto optimization::configuration() const -> std::string {
+    return "O" + std::to_string(static_cast<int>(level)) + (per_function ? " per-function\n" : "\n");
+}
+
+[[nodiscard]] auto codegen_level(opt_level level) -> llvm::CodeGenOpt::Level {
+    switch(level) {
+	case opt_level::O0: return llvm::CodeGenOpt::None;
+	case opt_level::O1: return llvm::CodeGenOpt::Less;
+	case opt_level::O2: return llvm::CodeGenOpt::Default;
+	case opt_level::O3: return llvm::CodeGenOpt::Aggressive;
+    }
+    return llvm::CodeGenOpt::Default;
+}
+
+optimizer::optimizer() {
+    _builder.registerModuleAnalyses(_module_analyses);
+    _builder.registerCGSCCAnalyses(_cgscc_analyses);
+    _builder.registerFunctionAnalyses(_function_analyses);
+    _builder.registerLoopAnalyses(_loop_analyses);
+    _builder.crossRegisterProxies(_loop_analyses, _function_analyses, _cgscc_analyses, _module_analyses);
+    _function_pipeline = _builder.buildFunctionSimplificationPipeline(llvm::OptimizationLevel::O1, llvm::ThinOrFullLTOPhase::None);
+}
+
+auto optimizer::run(llvm::Function& function) -> void {
+    _function_pipeline.run(function, _function_analyses);
+    clear();
+}
+
+auto optimizer::run(llvm::Module& module, opt_level level) -> void {
+    if(level == opt_level::O0)
+	return;
+    auto pipeline = _builder.buildPerModuleDefaultPipeline(pass_level(level));
+    pipeline.run(module, _module_analyses);
+    clear();
+}
+
+auto optimizer::clear() -> void {
+    // results are keyed by addresses of IR units, a freed unit must not leave results behind for its successor
+    _loop_analyses.clear();
+    _function_analyses.clear();
+    _cgscc_analyses.clear();
+    _module_analyses.clear();
+}
@@ -7,105 +7,121 @@
 #include "ast/floating_literal.hpp"
 #include "ast/integer_literal.hpp"
 #include "global_context.hpp"
+#include "integer_value.hpp"
 #include "lexer.hpp"
 #include "parser.hpp"
+#include "trace.hpp"
 
-parser::parser(lexer&& _lexer, operator_table&& _table) 
-    : _lexer{std::move(_lexer)}
-    , _table{std::move(_table)}
+parser::parser(lexer&& _lexer, const operator_precedence& _table, ast::arena& _arena) 
+    : _tokens{std::move(_lexer)}
+    , _table{_table}
+    , _arena{_arena}
 {}
 
 // literal_expression ::= literal
-[[nodiscard]] auto parser::parse_literal() -> std::unique_ptr<ast::expression> {
-    std::unique_ptr<ast::expression> result;
-    switch(_lexer.token()) {
+[[nodiscard]] auto parser::parse_literal() -> ast::expression* {
+    // digits are converted once here, analysis and code generation use the value
+    auto integer = [this] (uint8_t radix) -> ast::expression* {
+	auto value = integer_value::parse(_tokens.identifier(), radix);
+	if(!value) {
+	    fprintf(stderr, "error: integer literal does not fit into 128 bits: \"%.*s\"", static_cast<int>(_tokens.identifier().size()), _tokens.identifier().data());
+	    return nullptr;
+	}
+	return _arena.make<ast::integer_literal_expression>(_tokens.identifier(), *value, radix);
+    };
+
+    ast::expression* result;
+    switch(_tokens.token()) {
 	case tokens::binary:
-	    result = std::make_unique<ast::integer_literal_expression>(std::move(_lexer.identifier()), 2);
+	    result = integer(2);
 	    break;
 	case tokens::octal: 
-	    result = std::make_unique<ast::integer_literal_expression>(std::move(_lexer.identifier()), 8);
+	    result = integer(8);
 	    break;
 	case tokens::decimal: 
-	    result = std::make_unique<ast::integer_literal_expression>(std::move(_lexer.identifier()), 10);
+	    result = integer(10);
 	    break;
 	case tokens::hexadecimal:
-	    result = std::make_unique<ast::integer_literal_expression>(std::move(_lexer.identifier()), 16);
+	    result = integer(16);
 	    break;
 	case tokens::floating:
-	    result = std::make_unique<ast::floating_literal_expression>(std::move(_lexer.identifier()));
+	    result = _arena.make<ast::floating_literal_expression>(_tokens.identifier());
 	    break;
 	case tokens::character:
-	    result = std::make_unique<ast::character_literal_expression>(std::move(_lexer.identifier()));
+	    result = _arena.make<ast::character_literal_expression>(_tokens.identifier());
 	    break;
 	case tokens::string:
-	    result = std::make_unique<ast::string_literal_expression>(std::move(_lexer.identifier()));
+	    result = _arena.make<ast::string_literal_expression>(_tokens.identifier());
 	    break;
 	default:
-	    fprintf(stderr, "error: unrecognised literal type, with token: \"%s\"", _lexer.identifier().data());
+	    fprintf(stderr, "error: unrecognised literal type, with token: \"%.*s\"", static_cast<int>(_tokens.identifier().size()), _tokens.identifier().data());
 	    return nullptr;
     }
-    _lexer.consume();
+    if(!result)
+	return nullptr;
+    _tokens.consume();
     return result;
 }
 
 // parenthesis ::= '(' expression ')'
-[[nodiscard]] auto parser::parse_parenthesis() -> std::unique_ptr<ast::expression> {
-    fprintf(stderr, "parsing parenthesis with token = \"%s\"\n", _lexer.identifier().data());
-    _lexer.consume();
+[[nodiscard]] auto parser::parse_parenthesis() -> ast::expression* {
+    TRACE(parser, debug, "parsing parenthesis with token = \"%.*s\"", static_cast<int>(_tokens.identifier().size()), _tokens.identifier().data());
+    _tokens.consume();
 
     auto expr = parse_expression();
     if(!expr)
 	return nullptr;
 
-    if(_lexer.token() != tokens::right_parenthesis) {
-	fprintf(stderr, "error: expected ')', found \"%s\"", _lexer.identifier().data());
+    if(_tokens.token() != tokens::right_parenthesis) {
+	fprintf(stderr, "error: expected ')', found \"%.*s\"", static_cast<int>(_tokens.identifier().size()), _tokens.identifier().data());
 	return nullptr;
     }
 
-    _lexer.consume();
-    fprintf(stderr, "finished parsing parenthesis with token = \"%s\"\n", _lexer.identifier().data());
+    _tokens.consume();
+    TRACE(parser, debug, "finished parsing parenthesis with token = \"%.*s\"", static_cast<int>(_tokens.identifier().size()), _tokens.identifier().data());
     return expr;
 }
 
 // indentifierExpr 
 //			::= indentifier
 //			::= indentifier '(' expression* ')'
-[[nodiscard]] auto parser::parse_indentifier() -> std::unique_ptr<ast::expression> {
-    std::string identifier = _lexer.identifier();
-    _lexer.consume();
+[[nodiscard]] auto parser::parse_indentifier() -> ast::expression* {
+    symbol identifier = _tokens.interned();
+    _tokens.consume();
 
-    if(_lexer.token() != tokens::left_parenthesis)
-	return std::make_unique<ast::variable_expression>(std::move(identifier));
+    if(_tokens.token() != tokens::left_parenthesis)
+	return _arena.make<ast::variable_expression>(identifier);
 
-    std::vector<std::unique_ptr<ast::expression>> args;
+    auto args = _arena.make_list<ast::expression*>();
 
-    while(_lexer.token() != tokens::right_parenthesis) {
-	_lexer.consume();
+    while(_tokens.token() != tokens::right_parenthesis) {
+	_tokens.consume();
 
 	if(auto arg = parse_expression())
-	    args.emplace_back(std::move(arg));
+	    args.emplace_back(arg);
 	else
 	    return nullptr;
 
 
-	if(auto t = _lexer.token(); 
+	if(auto t = _tokens.token(); 
 		t != tokens::right_parenthesis && t != tokens::comma) {
 	    fprintf(stderr, "error: expected ')' or ','");
 	    return nullptr;
 	}
     }
-    _lexer.consume();
+    _tokens.consume();
 
-    return std::make_unique<ast::call_expression>(std::move(identifier), std::move(args));
+    _callees.push_back(identifier);
+    return _arena.make<ast::call_expression>(identifier, std::move(args));
 }
 
 // primary 
 //		::= indentifierExpr
 //		::= literal
 //		::= parenthesis
-[[nodiscard]] auto parser::parse_primary() -> std::unique_ptr<ast::expression> {
-    fprintf(stderr, "parsing primary exprssion\n");
-    switch (_lexer.token()) {
+[[nodiscard]] auto parser::parse_primary() -> ast::expression* {
+    TRACE(parser, debug, "parsing primary exprssion");
+    switch (_tokens.token()) {
 	case tokens::identifier:
 	    return parse_indentifier();
 	case tokens::decimal: [[fallthrough]];
@@ -119,148 +135,178 @@ parser::parser(lexer&& _lexer, operator_table&& _table)
 	case tokens::left_parenthesis:
 	    return parse_parenthesis();
 	default:
-	    fprintf(stderr, "error: unknown token in expression: %d - \"%s\"", _lexer.token(), _lexer.identifier().data());
+	    fprintf(stderr, "error: unknown token in expression: %d - \"%.*s\"", static_cast<int>(_tokens.token()), static_cast<int>(_tokens.identifier().size()), _tokens.identifier().data());
 	    return nullptr;
     }
 }
 
 // expression ::= primary binary
-[[nodiscard]] auto parser::parse_expression() -> std::unique_ptr<ast::expression> {
-    fprintf(stderr, "parsing expression with token = \"%s\"\n", _lexer.identifier().data());
+[[nodiscard]] auto parser::parse_expression() -> ast::expression* {
+    TRACE(parser, debug, "parsing expression with token = \"%.*s\"", static_cast<int>(_tokens.identifier().size()), _tokens.identifier().data());
     auto lhs = parse_primary();
     if(!lhs)
 	return nullptr;
 
-    return parse_binary_rhs(1, std::move(lhs));
+    return parse_binary_rhs(1, lhs);
 }
 
 // binary ::= (op prmary)*
-[[nodiscard]] auto parser::parse_binary_rhs(uint8_t precedence, std::unique_ptr<ast::expression>&& lhs) -> std::unique_ptr<ast::expression> {
-    fprintf(stderr, "parsing binary rhs with token = \"%s\"\n", _lexer.identifier().data());
-    while(_lexer.token() == tokens::identifier) {
-	uint16_t current_precedence = _table[_lexer.identifier()];
+[[nodiscard]] auto parser::parse_binary_rhs(uint8_t precedence, ast::expression* lhs) -> ast::expression* {
+    TRACE(parser, debug, "parsing binary rhs with token = \"%.*s\"", static_cast<int>(_tokens.identifier().size()), _tokens.identifier().data());
+    while(_tokens.token() == tokens::identifier) {
+	uint16_t current_precedence = _table[_tokens.interned()];
 
 	if(current_precedence < precedence)
 	    return lhs;
 
-	std::string op = std::move(_lexer.identifier());
-	_lexer.consume();
+	symbol op = _tokens.interned();
+	_tokens.consume();
 
 	auto rhs = parse_primary();
 	if(!rhs)
 	    return nullptr;
 
-	uint16_t next_precedence = _table[_lexer.identifier()];
+	uint16_t next_precedence = _table[_tokens.interned()];
 	if(current_precedence < next_precedence) {
-	    rhs = parse_binary_rhs(current_precedence + 1, std::move(rhs));
+	    rhs = parse_binary_rhs(current_precedence + 1, rhs);
 	    if(!rhs)
 		return nullptr;
 	}
 
-	lhs = std::make_unique<ast::binary_expression>(std::move(op), std::move(lhs), std::move(rhs));
+	lhs = _arena.make<ast::binary_expression>(op, lhs, rhs);
     }
-    fprintf(stderr, "finished parsing binary rhs with token = \"%s\"\n", _lexer.identifier().data());
+    TRACE(parser, debug, "finished parsing binary rhs with token = \"%.*s\"", static_cast<int>(_tokens.identifier().size()), _tokens.identifier().data());
     return lhs;
 }
 
-[[nodiscard]] auto parser::parse_function() -> std::unique_ptr<ast::function_expression> {
+[[nodiscard]] auto parser::parse_function() -> ast::function_expression* {
     // check if function definition starts with 'function' key word
-    if(_lexer.identifier() != "function") {
-	fprintf(stderr, "expected 'function' in function definition");
+    if(_tokens.token() != tokens::function_token) {
+	fprintf(stderr, "error: expected 'function' in function definition");
 	return nullptr;
     }
-    _lexer.consume();
+    _tokens.reset_fingerprint();
+    _callees.clear();
+    _tokens.consume();
 
     // parse name if there is one
-    std::string name{};
-    if(_lexer.token() == tokens::identifier) {
-	name = std::move(_lexer.identifier());
-	_lexer.consume();
+    symbol name{};
+    if(_tokens.token() == tokens::identifier) {
+	name = _tokens.interned();
+	_tokens.consume();
     }
 
     // check for '(' before argument list
-    if(_lexer.token() != tokens::left_parenthesis) {
+    if(_tokens.token() != tokens::left_parenthesis) {
 	fprintf(stderr, "error: expected '(' in function definition");
 	return nullptr;
     }
-    _lexer.consume();
+    _tokens.consume();
 
     // parse argument list in form of: arg_name arg_type
-    std::vector<std::string> args;
-    std::vector<std::string> arg_types;
-    while(_lexer.token() == tokens::identifier) {
-	args.emplace_back(std::move(_lexer.identifier()));
-	_lexer.consume();
-
-	if(_lexer.token() != tokens::identifier) {
-	    fprintf(stderr, "error: expected argument type after argument name, found: \"%s\"", _lexer.identifier().data());
+    auto args = _arena.make_list<symbol>();
+    auto arg_types = _arena.make_list<symbol>();
+    while(_tokens.token() == tokens::identifier) {
+	args.emplace_back(_tokens.interned());
+	_tokens.consume();
+
+	if(_tokens.token() != tokens::identifier) {
+	    fprintf(stderr, "error: expected argument type after argument name, found: \"%.*s\"", static_cast<int>(_tokens.identifier().size()), _tokens.identifier().data());
 	    return nullptr;
 	}
 
-	arg_types.emplace_back(std::move(_lexer.identifier()));
-	_lexer.consume();
+	arg_types.emplace_back(_tokens.interned());
+	_tokens.consume();
 
-	if(_lexer.token() == tokens::comma)
-	    _lexer.consume();
+	if(_tokens.token() == tokens::comma)
+	    _tokens.consume();
     }
 
     // check for ')' after argument list
-    if(_lexer.token() != tokens::right_parenthesis) {
+    if(_tokens.token() != tokens::right_parenthesis) {
 	fprintf(stderr, "error: expected ')'");
 	return nullptr;
     }
-    _lexer.consume();
+    _tokens.consume();
 
-    std::string return_type{};
-    if(_lexer.token() == tokens::identifier) {
-	return_type = std::move(_lexer.identifier());
-	_lexer.consume();
+    symbol return_type{};
+    if(_tokens.token() == tokens::identifier) {
+	return_type = _tokens.interned();
+	_tokens.consume();
     }
 
     // parse body of a function
     auto body = parse_block();
     if(!body)
 	return nullptr;
-    fprintf(stderr, "finished parsing block\n");
+    TRACE(parser, debug, "finished parsing block");
 
-    return std::make_unique<ast::function_expression>(std::move(name), std::move(args), std::move(arg_types), std::move(return_type), std::move(body));
+    auto callees = _arena.make_list<symbol>();
+    callees.assign(_callees.begin(), _callees.end());
+    return _arena.make<ast::function_expression>(name, std::move(args), std::move(arg_types), return_type, body, _tokens.fingerprint(), std::move(callees));
 }
 
-[[nodiscard]] auto parser::parse_block() -> std::unique_ptr<ast::block_expression> {
-    if(_lexer.token() != tokens::eol && _lexer.token() != tokens::left_curly_brace) {
+[[nodiscard]] auto parser::parse_block() -> ast::block_expression* {
+    if(_tokens.token() != tokens::eol && _tokens.token() != tokens::left_curly_brace) {
 	fprintf(stderr, "error: expected new line or '{' in the beginning of the block");
 	return nullptr;
     }
 
-    std::vector<std::unique_ptr<ast::expression>> expressions;
-    if(_lexer.token() == tokens::eol) { // found eol
-	_lexer.consume();
-	fprintf(stderr, "found eol, creating return expression\n");
+    auto expressions = _arena.make_list<ast::expression*>();
+    if(_tokens.token() == tokens::eol) { // found eol
+	_tokens.consume();
+	TRACE(parser, debug, "found eol, creating return expression");
 	auto expr = parse_expression();
 	if(!expr)
 	    return nullptr;
-	expressions.emplace_back(std::move(expr));
+	expressions.emplace_back(expr);
     } else {                            // found '{'
-	_lexer.consume();
-	if(_lexer.token() != tokens::eol) {
+	_tokens.consume();
+	if(_tokens.token() != tokens::eol) {
 	    fprintf(stderr, "error: expected new line after '{'");
 	    return nullptr;
 	}
-	_lexer.consume();
+	_tokens.consume();
 	bool is_return = false;
-	while(_lexer.token() != tokens::right_curly_brace && !is_return) {
-	    fprintf(stderr, "found token = \"%s\"\n", _lexer.identifier().data());
-	    if(_lexer.token() == tokens::return_token) {
+	while(_tokens.token() != tokens::right_curly_brace && !is_return) {
+	    TRACE(parser, debug, "found token = \"%.*s\"", static_cast<int>(_tokens.identifier().size()), _tokens.identifier().data());
+	    if(_tokens.token() == tokens::return_token) {
 		is_return = true;
-		_lexer.consume();
+		_tokens.consume();
 	    }
 	    auto expr = parse_expression();
 	    if(!expr)
 		return nullptr;
-	    expressions.emplace_back(std::move(expr));
-	    _lexer.consume();
+	    expressions.emplace_back(expr);
+	    _tokens.consume();
 	}
+	if(_tokens.token() != tokens::right_curly_brace) {
+	    fprintf(stderr, "error: expected '}' in the end of the block");
+	    return nullptr;
+	}
+	_tokens.consume();
     }
 
-    return std::make_unique<ast::block_expression>(std::move(expressions));
+    return _arena.make<ast::block_expression>(std::move(expressions));
+}
+
+// module ::= (eol* function)* eol* eof
+[[nodiscard]] auto parser::parse_module() -> std::optional<ast::function_list> {
+    auto functions = _arena.make_list<ast::function_expression*>();
+    while(true) {
+	while(_tokens.token() == tokens::eol)
+	    _tokens.consume();
+	if(_tokens.token() == tokens::eof)
+	    break;
+
+	auto function = parse_function();
+	if(!function)
+	    return std::nullopt;
+	functions.emplace_back(function);
+    }
+    return functions;
+}
+
+[[nodiscard]] auto parser::token_count() const noexcept -> std::size_t {
+    return _tokens.token_count();
 }
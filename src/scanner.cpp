@@ -0,0 +1,256 @@
+#include <algorithm>
+#include <atomic>
+#include <bit>
+
+#include "char_class.hpp"
+#include "scanner.hpp"
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#define SCANNER_X86 1
+#endif
+
+namespace {
+
+    namespace scalar {
+
+	struct identifier {
+	    constexpr auto operator()(char ch) const noexcept -> bool {
+		return has_class(ch, char_class::alpha | char_class::digit);
+	    }
+	};
+
+	struct blank {
+	    constexpr auto operator()(char ch) const noexcept -> bool {
+		return has_class(ch, char_class::blank);
+	    }
+	};
+
+	struct digit {
+	    constexpr auto operator()(char ch) const noexcept -> bool {
+		return has_class(ch, char_class::digit) || ch == '_';
+	    }
+	};
+
+	struct eol {
+	    constexpr auto operator()(char ch) const noexcept -> bool {
+		return has_class(ch, char_class::eol);
+	    }
+	};
+
+	struct star {
+	    constexpr auto operator()(char ch) const noexcept -> bool {
+		return ch == '*';
+	    }
+	};
+
+	/**
+	 * Scan one character at a time
+	 * @tparam Predicate a class of characters
+	 * @tparam Skip if true skip characters of class, otherwise stop at the first one
+	 */
+	template<typename Predicate, bool Skip>
+	auto scan(const char* begin, const char* end) noexcept -> const char* {
+	    while(begin != end && Predicate{}(*begin) == Skip)
+		++begin;
+	    return begin;
+	}
+
+	constexpr scanner routines {
+	    .skip_identifier = scan<identifier, true>,
+	    .skip_blanks     = scan<blank, true>,
+	    .skip_digits     = scan<digit, true>,
+	    .find_eol        = scan<eol, false>,
+	    .find_star       = scan<star, false>,
+	};
+
+    }
+
+#ifdef SCANNER_X86
+
+    // Predicates below return a vector with 0xFF in every byte that matches a class.
+    // Ranges use unsigned saturation: lo <= v <= hi  <=>  max(v - lo, hi - lo) == hi - lo
+
+    namespace sse2 {
+
+	using vector = __m128i;
+
+	inline auto equals(vector v, char ch) noexcept -> vector {
+	    return _mm_cmpeq_epi8(v, _mm_set1_epi8(ch));
+	}
+
+	inline auto in_range(vector v, char lo, char hi) noexcept -> vector {
+	    vector limit = _mm_set1_epi8(static_cast<char>(hi - lo));
+	    return _mm_cmpeq_epi8(_mm_max_epu8(_mm_sub_epi8(v, _mm_set1_epi8(lo)), limit), limit);
+	}
+
+	struct identifier {
+	    auto operator()(vector v) const noexcept -> vector {
+		vector lower = _mm_or_si128(v, _mm_set1_epi8(0x20));
+		return _mm_or_si128(_mm_or_si128(in_range(lower, 'a', 'z'), in_range(v, '0', '9')), equals(v, '_'));
+	    }
+	};
+
+	struct blank {
+	    auto operator()(vector v) const noexcept -> vector {
+		return _mm_or_si128(_mm_or_si128(equals(v, ' '), equals(v, '\t')), in_range(v, '\v', '\f'));
+	    }
+	};
+
+	struct digit {
+	    auto operator()(vector v) const noexcept -> vector {
+		return _mm_or_si128(in_range(v, '0', '9'), equals(v, '_'));
+	    }
+	};
+
+	struct eol {
+	    auto operator()(vector v) const noexcept -> vector {
+		return _mm_or_si128(equals(v, '\n'), equals(v, '\r'));
+	    }
+	};
+
+	struct star {
+	    auto operator()(vector v) const noexcept -> vector {
+		return equals(v, '*');
+	    }
+	};
+
+	/**
+	 * Scan 16 characters at a time, tail is handled by scalar fallback
+	 * @tparam Predicate a class of characters
+	 * @tparam Skip if true skip characters of class, otherwise stop at the first one
+	 */
+	template<typename Predicate, bool Skip, scanner::scan_function Tail>
+	auto scan(const char* begin, const char* end) noexcept -> const char* {
+	    for(; end - begin >= static_cast<std::ptrdiff_t>(sizeof(vector)); begin += sizeof(vector)) {
+		vector chunk = _mm_loadu_si128(reinterpret_cast<const vector*>(begin));
+		uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(Predicate{}(chunk)));
+		if constexpr(Skip)
+		    mask = ~mask & 0xFFFF;
+		if(mask)
+		    return begin + std::countr_zero(mask);
+	    }
+	    return Tail(begin, end);
+	}
+
+	constexpr scanner routines {
+	    .skip_identifier = scan<identifier, true, scalar::routines.skip_identifier>,
+	    .skip_blanks     = scan<blank, true, scalar::routines.skip_blanks>,
+	    .skip_digits     = scan<digit, true, scalar::routines.skip_digits>,
+	    .find_eol        = scan<eol, false, scalar::routines.find_eol>,
+	    .find_star       = scan<star, false, scalar::routines.find_star>,
+	};
+
+    }
+
+    namespace avx2 {
+
+	using vector = __m256i;
+
+	[[gnu::target("avx2")]] inline auto equals(vector v, char ch) noexcept -> vector {
+	    return _mm256_cmpeq_epi8(v, _mm256_set1_epi8(ch));
+	}
+
+	[[gnu::target("avx2")]] inline auto in_range(vector v, char lo, char hi) noexcept -> vector {
+	    vector limit = _mm256_set1_epi8(static_cast<char>(hi - lo));
+	    return _mm256_cmpeq_epi8(_mm256_max_epu8(_mm256_sub_epi8(v, _mm256_set1_epi8(lo)), limit), limit);
+	}
+
+	struct identifier {
+	    [[gnu::target("avx2")]] auto operator()(vector v) const noexcept -> vector {
+		vector lower = _mm256_or_si256(v, _mm256_set1_epi8(0x20));
+		return _mm256_or_si256(_mm256_or_si256(in_range(lower, 'a', 'z'), in_range(v, '0', '9')), equals(v, '_'));
+	    }
+	};
+
+	struct blank {
+	    [[gnu::target("avx2")]] auto operator()(vector v) const noexcept -> vector {
+		return _mm256_or_si256(_mm256_or_si256(equals(v, ' '), equals(v, '\t')), in_range(v, '\v', '\f'));
+	    }
+	};
+
+	struct digit {
+	    [[gnu::target("avx2")]] auto operator()(vector v) const noexcept -> vector {
+		return _mm256_or_si256(in_range(v, '0', '9'), equals(v, '_'));
+	    }
+	};
+
+	struct eol {
+	    [[gnu::target("avx2")]] auto operator()(vector v) const noexcept -> vector {
+		return _mm256_or_si256(equals(v, '\n'), equals(v, '\r'));
+	    }
+	};
+
+	struct star {
+	    [[gnu::target("avx2")]] auto operator()(vector v) const noexcept -> vector {
+		return equals(v, '*');
+	    }
+	};
+
+	/**
+	 * Scan 32 characters at a time, tail is handled by SSE2 routine
+	 * @tparam Predicate a class of characters
+	 * @tparam Skip if true skip characters of class, otherwise stop at the first one
+	 */
+	template<typename Predicate, bool Skip, scanner::scan_function Tail>
+	[[gnu::target("avx2")]] auto scan(const char* begin, const char* end) noexcept -> const char* {
+	    for(; end - begin >= static_cast<std::ptrdiff_t>(sizeof(vector)); begin += sizeof(vector)) {
+		vector chunk = _mm256_loadu_si256(reinterpret_cast<const vector*>(begin));
+		uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(Predicate{}(chunk)));
+		if constexpr(Skip)
+		    mask = ~mask;
+		if(mask)
+		    return begin + std::countr_zero(mask);
+	    }
+	    return Tail(begin, end);
+	}
+
+	constexpr scanner routines {
+	    .skip_identifier = scan<identifier, true, sse2::routines.skip_identifier>,
+	    .skip_blanks     = scan<blank, true, sse2::routines.skip_blanks>,
+	    .skip_digits     = scan<digit, true, sse2::routines.skip_digits>,
+	    .find_eol        = scan<eol, false, sse2::routines.find_eol>,
+	    .find_star       = scan<star, false, sse2::routines.find_star>,
+	};
+
+    }
+
+#endif
+
+    std::atomic<const scanner*> active_scanner{&scanner::get(scanner::best_mode())}; ///< routines used by new lexers
+
+}
+
+[[nodiscard]] auto scanner::get(scan_mode mode) noexcept -> const scanner& {
+    switch(mode) {
+#ifdef SCANNER_X86
+	case scan_mode::sse2:
+	    return sse2::routines;
+	case scan_mode::avx2:
+	    return avx2::routines;
+#endif
+	default:
+	    return scalar::routines;
+    }
+}
+
+[[nodiscard]] auto scanner::active() noexcept -> const scanner& {
+    return *active_scanner.load(std::memory_order_relaxed);
+}
+
+auto scanner::select(scan_mode mode) noexcept -> scan_mode {
+    mode = std::min(mode, best_mode());
+    active_scanner.store(&get(mode), std::memory_order_relaxed);
+    return mode;
+}
+
+[[nodiscard]] auto scanner::best_mode() noexcept -> scan_mode {
+#ifdef SCANNER_X86
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2"))
+	return scan_mode::avx2;
+    if(__builtin_cpu_supports("sse2"))
+	return scan_mode::sse2;
+#endif
+    return scan_mode::scalar;
+}
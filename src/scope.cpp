@@ -1,19 +1,21 @@
 #include "scope.hpp"
 
-auto scope::new_symbol(const std::string& sym, types::type* type) -> void {
-    _symbols[sym] = type;
+auto scope::new_symbol(symbol sym, types::type* type) -> void {
+    _symbols.insert_or_assign(sym, type);
 }
 
-auto scope::new_function(const std::string& func, types::function_type* type) -> void {
-    _functions[func] = type;
+auto scope::new_function(symbol func, types::function_type* type) -> void {
+    _functions.insert_or_assign(func, type);
 }
 
-[[nodiscard]] auto scope::search_symbol(const std::string& sym) -> types::type* {
-    return _symbols[sym];
+[[nodiscard]] auto scope::search_symbol(symbol sym) -> types::type* {
+    auto found = _symbols.find(sym);
+    return found != _symbols.end() ? found->second : nullptr;
 }
 
-[[nodiscard]] auto scope::search_function(const std::string& func) -> types::function_type* {
-    return _functions[func];
+[[nodiscard]] auto scope::search_function(symbol func) -> types::function_type* {
+    auto found = _functions.find(func);
+    return found != _functions.end() ? found->second : nullptr;
 }
 
 
@@ -29,22 +31,22 @@ auto scope_manager::delete_scope() -> void {
     _scopes.pop_front();
 }
 
-auto scope_manager::new_symbol(const std::string& sym, types::type* type) -> void {
+auto scope_manager::new_symbol(symbol sym, types::type* type) -> void {
     _scopes.front().new_symbol(sym, type);
 }
 
-auto scope_manager::new_function(const std::string& func, types::function_type* type) -> void {
+auto scope_manager::new_function(symbol func, types::function_type* type) -> void {
     _scopes.front().new_function(func, type);
 }
 
-[[nodiscard]] auto scope_manager::search_symbol(const std::string& sym) -> types::type* {
+[[nodiscard]] auto scope_manager::search_symbol(symbol sym) -> types::type* {
     for(auto& s: _scopes)
 	if(auto type = s.search_symbol(sym))
 	    return type;
     return nullptr;
 }
 
-[[nodiscard]] auto scope_manager::search_function(const std::string& func) -> types::function_type* {
+[[nodiscard]] auto scope_manager::search_function(symbol func) -> types::function_type* {
     for(auto& s: _scopes)
 	if(auto type = s.search_function(func))
 	    return type;
@@ -1,4 +1,5 @@
-#include <limits>
+#include <algorithm>
+#include <array>
 #include <ranges>
 
 #include "semantic_analyzer.hpp"
@@ -6,21 +7,19 @@
 
 namespace {
 
-    auto cast_to(types::type* type) {
-	return [type] (std::unique_ptr<ast::expression>&& expr) { 
-	    return std::make_unique<ast::implicit_cast>(std::move(expr), type);
+    auto cast_to(ast::arena& arena, types::type* type) {
+	return [&arena, type] (ast::expression* expr) { 
+	    return arena.make<ast::implicit_cast>(expr, type);
 	};
     }
+}
 
-    template<std::ranges::forward_range Range, typename Value>
-    requires std::same_as<std::ranges::range_value_t<Range>, std::tuple<Value, Value, std::string>>
-    auto find_in_range_or_default(Range&& range, const Value& val, const std::string& _default) {
-	auto res = std::ranges::find_if(std::forward<Range&&>(range), [&val] (auto t) {
-	    const auto& [lower, upper, _] = t;
-	    return lower <= val && val <= upper;
-	});
-	return res == std::end(range) ? _default : get<2>(*res);
-    }
+semantic_analyzer::semantic_analyzer(ast::arena& arena)
+    : _arena{arena}
+{}
+
+auto semantic_analyzer::declare_function(symbol name, types::function_type* type) -> void {
+    _sm.new_function(name, type);
 }
 
 auto semantic_analyzer::visit(ast::expression* expr) -> types::type* {
@@ -28,28 +27,18 @@ auto semantic_analyzer::visit(ast::expression* expr) -> types::type* {
 }
 
 auto semantic_analyzer::visit(ast::integer_literal_expression* expr) -> types::type* {
-    using namespace std::literals;
-    const static std::vector<std::tuple<ast::integer_container, ast::integer_container, std::string>> unsigned_ranges {
-	{"0", std::to_string(std::numeric_limits<uint8_t>::max()), "uint8"},
-	{"0", std::to_string(std::numeric_limits<uint16_t>::max()), "uint16"},
-	{"0", std::to_string(std::numeric_limits<uint32_t>::max()), "uint32"},
-	{"0", std::to_string(std::numeric_limits<uint64_t>::max()), "uint64"},
-    };
-    const static std::vector<std::tuple<ast::integer_container, ast::integer_container, std::string>> signed_ranges {
-	{std::to_string(std::numeric_limits<int8_t>::min()), std::to_string(std::numeric_limits<int8_t>::max()), "int8"},
-	{std::to_string(std::numeric_limits<int16_t>::min()), std::to_string(std::numeric_limits<int16_t>::max()), "int16"},
-	{std::to_string(std::numeric_limits<int32_t>::min()), std::to_string(std::numeric_limits<int32_t>::max()), "int32"},
-	{std::to_string(std::numeric_limits<int64_t>::min()), std::to_string(std::numeric_limits<int64_t>::max()), "int64"},
-    };
-
-    types::type* final_type{};
-
-    if(const auto& v = expr->value(); v >= "0"s)
-	final_type = global_context::type(find_in_range_or_default(unsigned_ranges, v, "uint128"));
-    else
-	final_type = global_context::type(find_in_range_or_default(signed_ranges, v, "int128"));
-
-    return expr->type() = final_type;
+    // literals have no sign, so the narrowest unsigned type that holds all bits of value is taken
+    const static std::array<std::pair<unsigned, symbol>, 4> unsigned_widths {{
+	{8, interner::intern("uint8")},
+	{16, interner::intern("uint16")},
+	{32, interner::intern("uint32")},
+	{64, interner::intern("uint64")},
+    }};
+    const static symbol unsigned_default = interner::intern("uint128");
+
+    auto width = expr->value().bit_width();
+    auto found = std::ranges::find_if(unsigned_widths, [width] (const auto& w) { return width <= w.first; });
+    return expr->type() = global_context::type(found == unsigned_widths.end() ? unsigned_default : found->second);
 }
 
 auto semantic_analyzer::visit(ast::floating_literal_expression* expr) -> types::type* {
@@ -74,21 +63,23 @@ auto semantic_analyzer::visit(ast::binary_expression* expr) -> types::type* {
     if(!lhs_type || !rhs_type)
 	return nullptr;
     
-    types::type* common_type;
+    types::type* common_type{};
     if(lhs_type == rhs_type) {
 	common_type = lhs_type;
     } else if(global_context::cast(lhs_type, rhs_type)) {
-	expr->insert_lhs_cast(cast_to(rhs_type));
+	expr->insert_lhs_cast(cast_to(_arena, rhs_type));
 	common_type = rhs_type;
     } else if(global_context::cast(rhs_type, lhs_type)) {
-	expr->insert_rhs_cast(cast_to(lhs_type));
+	expr->insert_rhs_cast(cast_to(_arena, lhs_type));
 	common_type = lhs_type;
     } else {
 	fprintf(stderr, "error: unable to cast binary expression to common type: \"%s\" and \"%s\"", lhs_type->name().data(), rhs_type->name().data());
+	return nullptr;
     }
 
     if(!global_context::binary_operation(expr->op(), common_type)) {
-	fprintf(stderr, "error: no suitable \"%s\" operation for type \"%s\"", expr->op().data(), common_type->name().data());
+	auto op = interner::spelling(expr->op());
+	fprintf(stderr, "error: no suitable \"%.*s\" operation for type \"%s\"", static_cast<int>(op.size()), op.data(), common_type->name().data());
 	return nullptr;
     }
 
@@ -97,8 +88,11 @@ auto semantic_analyzer::visit(ast::binary_expression* expr) -> types::type* {
 
 auto semantic_analyzer::visit(ast::call_expression* expr) -> types::type* {
     types::function_type* func_type = _sm.search_function(expr->callee());
-    if(!func_type)
+    if(!func_type) {
+	auto callee = interner::spelling(expr->callee());
+	fprintf(stderr, "error: unknown function \"%.*s\"", static_cast<int>(callee.size()), callee.data());
 	return nullptr;
+    }
 
     if(func_type->get_num_params() != expr->args().size())
 	return nullptr;
@@ -114,7 +108,7 @@ auto semantic_analyzer::visit(ast::call_expression* expr) -> types::type* {
 	    fprintf(stderr, "error: unable to cast function call argument: \"%s\" required, \"%s\" given", (*arg_type)->name().data(), type->name().data());
 	    return nullptr;
 	} else if(type != *arg_type)
-	    expr->insert_arg_cast(arg, cast_to(*arg_type));
+	    expr->insert_arg_cast(arg, cast_to(_arena, *arg_type));
     }
 
     return expr->type() = func_type->get_return_type();
@@ -137,7 +131,7 @@ auto semantic_analyzer::visit(ast::function_expression* expr) -> types::type* {
 	fprintf(stderr, "error: uncompatable return value type \"%s\" and return function type \"%s\"", type->name().data(), return_type->name().data());
 	return nullptr;
     } else if(type != func_type->get_return_type())
-	expr->body()->insert_result_cast(cast_to(return_type));
+	expr->body()->insert_result_cast(cast_to(_arena, return_type));
 
     return expr->type() = func_type;
 }
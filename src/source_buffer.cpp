@@ -0,0 +1,43 @@
+#include <stdexcept>
+#include <string>
+
+#include "source_buffer.hpp"
+
+source_buffer::source_buffer(std::string_view filename) {
+    auto buffer = llvm::MemoryBuffer::getFileOrSTDIN(llvm::StringRef{filename.data(), filename.size()}, /* IsText */ false, /* RequiresNullTerminator */ true);
+    if(!buffer)
+	throw std::runtime_error("Unable to read from file");
+    _buffer = std::move(*buffer);
+}
+
+source_buffer::source_buffer() {
+    auto buffer = llvm::MemoryBuffer::getSTDIN();
+    if(!buffer)
+	throw std::runtime_error("Unable to read from standard input");
+    _buffer = std::move(*buffer);
+}
+
+source_buffer::source_buffer(std::unique_ptr<llvm::MemoryBuffer> buffer)
+    : _buffer{std::move(buffer)}
+{}
+
+[[nodiscard]] auto source_buffer::begin() const noexcept -> const char* {
+    return _buffer->getBufferStart();
+}
+
+[[nodiscard]] auto source_buffer::end() const noexcept -> const char* {
+    return _buffer->getBufferEnd();
+}
+
+[[nodiscard]] auto source_buffer::size() const noexcept -> std::size_t {
+    return _buffer->getBufferSize();
+}
+
+[[nodiscard]] auto source_buffer::text() const noexcept -> std::string_view {
+    return {begin(), size()};
+}
+
+[[nodiscard]] auto source_buffer::name() const noexcept -> std::string_view {
+    auto name = _buffer->getBufferIdentifier();
+    return {name.data(), name.size()};
+}
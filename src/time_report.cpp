@@ -0,0 +1,72 @@
+#include <string_view>
+
+#include <sys/resource.h>
+
+#include <llvm/Support/Format.h>
+#include <llvm/Support/JSON.h>
+
+#include "time_report.hpp"
+
+namespace {
+
+    constexpr std::array<std::string_view, time_report::phase_count> phase_names = {"parse", "sema", "codegen", "verify", "link", "optimize", "emit"};
+    constexpr std::array<std::string_view, time_report::counter_count> counter_names = {"files", "functions", "tokens", "ast_nodes", "ast_bytes", "instructions", "cache_hits"};
+
+    /**
+     * Get peak resident set size of process in kilobytes, 0 if it is unknown
+     */
+    auto peak_rss() -> uint64_t {
+	rusage usage{};
+	if(getrusage(RUSAGE_SELF, &usage) != 0)
+	    return 0;
+	return static_cast<uint64_t>(usage.ru_maxrss);
+    }
+
+    auto milliseconds(uint64_t nanoseconds) -> double {
+	return static_cast<double>(nanoseconds) / 1e6;
+    }
+
+    auto print_table(llvm::raw_ostream& out, uint64_t wall) -> void {
+	out << "===" << std::string(60, '-') << "===\n";
+	out << "                      Compilation time report\n";
+	out << "===" << std::string(60, '-') << "===\n";
+	out << llvm::format("  Total wall time: %.3f ms\n\n", milliseconds(wall));
+	out << "   Time (ms)  ---  Phase (summed over threads)\n";
+	for(std::size_t i = 0; i < time_report::phase_count; ++i) {
+	    auto name = phase_names[i];
+	    auto indent = static_cast<time_report::phase>(i) == time_report::phase::verify ? "  " : ""; // part of codegen
+	    out << llvm::format("  %10.3f  ---  %s%.*s\n", milliseconds(time_report::nanoseconds[i].load()), indent, static_cast<int>(name.size()), name.data());
+	}
+	out << "\n       Count  ---  Counter\n";
+	for(std::size_t i = 0; i < time_report::counter_count; ++i) {
+	    auto name = counter_names[i];
+	    out << llvm::format("  %10llu  ---  %.*s\n", static_cast<unsigned long long>(time_report::counters[i].load()), static_cast<int>(name.size()), name.data());
+	}
+	out << llvm::format("  %10llu  ---  peak_rss_kb\n", static_cast<unsigned long long>(peak_rss()));
+    }
+
+    auto print_json(llvm::raw_ostream& out, uint64_t wall) -> void {
+	llvm::json::OStream json{out};
+	json.object([&] {
+	    json.attribute("wall_ns", wall);
+	    json.attributeObject("phases_ns", [&] {
+		for(std::size_t i = 0; i < time_report::phase_count; ++i)
+		    json.attribute(phase_names[i], time_report::nanoseconds[i].load());
+	    });
+	    json.attributeObject("counters", [&] {
+		for(std::size_t i = 0; i < time_report::counter_count; ++i)
+		    json.attribute(counter_names[i], time_report::counters[i].load());
+	    });
+	    json.attribute("peak_rss_kb", peak_rss());
+	});
+	out << '\n';
+    }
+
+}
+
+auto time_report::print(llvm::raw_ostream& out, format f, uint64_t wall_nanoseconds) -> void {
+    if(f == format::json)
+	print_json(out, wall_nanoseconds);
+    else
+	print_table(out, wall_nanoseconds);
+}
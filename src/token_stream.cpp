@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <cassert>
+
+#include "chunk_lexer.hpp"
+#include "token_stream.hpp"
+#include "trace.hpp"
+
+namespace {
+
+    constexpr uint64_t fnv_offset = 0xcbf29ce484222325ull;
+    constexpr uint64_t fnv_prime  = 0x100000001b3ull;
+
+    constexpr uint32_t mask = token_stream::capacity - 1;
+    static_assert((token_stream::capacity & mask) == 0, "capacity of token ring must be a power of two");
+    static_assert(token_stream::batch < token_stream::capacity, "side waiting for batch would never be woken up");
+
+}
+
+token_stream::token_stream(lexer&& source_lexer, strategy how)
+    : _lexer{std::move(source_lexer)}
+{
+    if(how == strategy::automatic) {
+	bool cores = std::thread::hardware_concurrency() > 1;
+	if(cores && _lexer.size() >= 2 * chunk_lexer::min_chunk)
+	    how = strategy::parallel;
+	else if(cores && _lexer.size() >= pipeline_threshold)
+	    how = strategy::pipelined;
+	else
+	    how = strategy::on_demand;
+    }
+
+    if(how == strategy::parallel) {
+	_lexed = chunk_lexer::lex(_lexer, 0);
+	_available = static_cast<uint32_t>(_lexed.size());
+	_finished = true;
+    } else if(how == strategy::pipelined) {
+	// thread is started last, all members it touches are initialized by now
+	TRACE(lexer, info, "lexing %zu bytes on producer thread", _lexer.size());
+	_producer = std::thread{[this] { produce(); }};
+    }
+}
+
+token_stream::~token_stream() {
+    if(!_producer.joinable())
+	return;
+    // move tail, so that producer waiting for free slot wakes up and sees stop
+    _stopped.store(true, std::memory_order_release);
+    _tail.fetch_add(1, std::memory_order_release);
+    _tail.notify_one();
+    _producer.join();
+}
+
+[[nodiscard]] auto token_stream::peek(uint32_t n) noexcept -> const token_record& {
+    if(!_lexed.empty())
+	return _lexed[std::min<std::size_t>(std::size_t{_position} + n, _lexed.size() - 1)];
+
+    assert(n < capacity);
+    if(_available - _position <= n)
+	fill(n);
+    // after eof nothing is pushed, so eof is the last available token
+    uint32_t index = _available - _position > n ? _position + n : _available - 1;
+    return _ring[index & mask];
+}
+
+[[nodiscard]] auto token_stream::token() noexcept -> tokens {
+    return peek(0).kind;
+}
+
+[[nodiscard]] auto token_stream::identifier() noexcept -> std::string_view {
+    return text(peek(0).span);
+}
+
+[[nodiscard]] auto token_stream::interned() noexcept -> symbol {
+    return peek(0).interned;
+}
+
+[[nodiscard]] auto token_stream::text(source_span span) const noexcept -> std::string_view {
+    return _lexer.text(span);
+}
+
+auto token_stream::consume() noexcept -> void {
+    const auto& current = peek(0);
+
+    // FNV-1a of kind and text of consumed token, terminated so that adjacent tokens cannot merge
+    _fingerprint = (_fingerprint ^ static_cast<uint8_t>(current.kind)) * fnv_prime;
+    for(char c: text(current.span))
+	_fingerprint = (_fingerprint ^ static_cast<uint8_t>(c)) * fnv_prime;
+    _fingerprint = (_fingerprint ^ 0xff) * fnv_prime;
+    ++_consumed;
+
+    if(current.kind == tokens::eof)
+	return;
+    ++_position;
+    if(_producer.joinable()) {
+	// waking producer for every token would turn pipeline into ping-pong of context switches
+	_tail.store(_position, std::memory_order_release);
+	if(_position % batch == 0)
+	    _tail.notify_one();
+    }
+}
+
+[[nodiscard]] auto token_stream::token_count() const noexcept -> std::size_t {
+    return _consumed;
+}
+
+[[nodiscard]] auto token_stream::fingerprint() const noexcept -> uint64_t {
+    return _fingerprint;
+}
+
+auto token_stream::reset_fingerprint() noexcept -> void {
+    _fingerprint = fnv_offset;
+}
+
+[[nodiscard]] auto token_stream::read() noexcept -> token_record {
+    auto record = token_record{_lexer.token(), _lexer.span(), _lexer.interned()};
+    if(record.kind != tokens::eof)
+	_lexer.consume();
+    return record;
+}
+
+auto token_stream::produce() noexcept -> void {
+    uint32_t head = 0;
+    while(true) {
+	uint32_t tail;
+	while(head - (tail = _tail.load(std::memory_order_acquire)) >= capacity) {
+	    if(_stopped.load(std::memory_order_acquire))
+		return;
+	    // consumer may wait for tokens of unfinished batch, e.g. when it peeks almost capacity tokens ahead
+	    _head.notify_one();
+	    _tail.wait(tail, std::memory_order_acquire);
+	}
+	if(_stopped.load(std::memory_order_relaxed))
+	    return;
+
+	auto record = read();
+	_ring[head & mask] = record;
+	_head.store(++head, std::memory_order_release);
+	if(head % batch == 0 || record.kind == tokens::eof)
+	    _head.notify_one();
+	if(record.kind == tokens::eof)
+	    return;
+    }
+}
+
+auto token_stream::fill(uint32_t n) noexcept -> void {
+    if(!_producer.joinable()) {
+	// ring is never full here, consumer asks for less than capacity tokens ahead
+	while(_available - _position <= n && !_finished) {
+	    auto record = read();
+	    _ring[_available++ & mask] = record;
+	    _finished = record.kind == tokens::eof;
+	}
+	return;
+    }
+
+    while(_available - _position <= n && !_finished) {
+	uint32_t head = _head.load(std::memory_order_acquire);
+	if(head == _available) {
+	    // producer may wait for slots freed since last batch, otherwise both sides would sleep
+	    _tail.notify_one();
+	    _head.wait(head, std::memory_order_acquire);
+	    continue;
+	}
+	_available = head;
+	_finished = _ring[(head - 1) & mask].kind == tokens::eof;
+    }
+}
@@ -0,0 +1,25 @@
+#include <cstdarg>
+#include <cstdio>
+#include <string_view>
+
+#include "trace.hpp"
+
+namespace {
+
+    constexpr std::array<std::string_view, trace::category_count> category_names = {"lexer", "parser", "sema", "codegen", "driver"};
+
+}
+
+auto trace::print(category c, const char* format, ...) -> void {
+    // whole line is formatted first, so that lines of concurrent threads do not interleave
+    char line[512];
+    auto name = category_names[static_cast<std::size_t>(c)];
+    int prefix = snprintf(line, sizeof(line), "[%.*s] ", static_cast<int>(name.size()), name.data());
+
+    va_list args;
+    va_start(args, format);
+    vsnprintf(line + prefix, sizeof(line) - prefix, format, args);
+    va_end(args);
+
+    fprintf(stderr, "%s\n", line);
+}
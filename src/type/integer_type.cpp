@@ -1,5 +1,5 @@
 #include "type/integer_type.hpp"
 
-types::integer_type::integer_type(llvm::IntegerType* type, std::string&& name) 
-    : types::type{type, std::move(name)}
+types::integer_type::integer_type(llvm::IntegerType* type, std::string&& name, builtin id) 
+    : types::type{type, std::move(name), id}
 {}
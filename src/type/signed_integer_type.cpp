@@ -1,8 +1,8 @@
 #include "type/signed_integer_type.hpp"
 #include "type/integer_type.hpp"
 
-types::signed_integer_type::signed_integer_type(llvm::IntegerType* type, std::string&& name)
-    : types::integer_type{type, std::move(name)}
+types::signed_integer_type::signed_integer_type(llvm::IntegerType* type, std::string&& name, builtin id)
+    : types::integer_type{type, std::move(name), id}
 {}
 
 [[nodiscard]] auto types::signed_integer_type::is_signed() const noexcept -> bool {
@@ -1,8 +1,42 @@
+#include <vector>
+
+#include <llvm/IR/DerivedTypes.h>
+
 #include "type/type.hpp"
 
-types::type::type(llvm::Type* type, std::string&& name)
+namespace {
+
+    auto translate(llvm::Type* type, llvm::LLVMContext& context) -> llvm::Type* {
+	switch(type->getTypeID()) {
+	    case llvm::Type::VoidTyID:
+		return llvm::Type::getVoidTy(context);
+	    case llvm::Type::FloatTyID:
+		return llvm::Type::getFloatTy(context);
+	    case llvm::Type::DoubleTyID:
+		return llvm::Type::getDoubleTy(context);
+	    case llvm::Type::IntegerTyID:
+		return llvm::IntegerType::get(context, type->getIntegerBitWidth());
+	    case llvm::Type::PointerTyID:
+		return llvm::PointerType::get(translate(type->getContainedType(0), context), type->getPointerAddressSpace());
+	    case llvm::Type::FunctionTyID: {
+		auto func_type = static_cast<llvm::FunctionType*>(type);
+		std::vector<llvm::Type*> params;
+		params.reserve(func_type->getNumParams());
+		for(auto param: func_type->params())
+		    params.push_back(translate(param, context));
+		return llvm::FunctionType::get(translate(func_type->getReturnType(), context), params, func_type->isVarArg());
+	    }
+	    default:
+		return nullptr;
+	}
+    }
+
+}
+
+types::type::type(llvm::Type* type, std::string&& name, builtin id)
     : _type{type}
     , _name{std::move(name)}
+    , _id{id}
 {}
 
 auto types::type::operator==(const type& other) const noexcept -> bool {
@@ -21,10 +55,20 @@ types::type::operator bool() const noexcept {
     return _type;
 }
 
+[[nodiscard]] auto types::type::get(llvm::LLVMContext& context) const -> llvm::Type* {
+    if(&_type->getContext() == &context)
+	return _type;
+    return translate(_type, context);
+}
+
 [[nodiscard]] auto types::type::name() const noexcept -> const std::string& {
     return _name;
 }
 
+[[nodiscard]] auto types::type::id() const noexcept -> builtin {
+    return _id;
+}
+
 [[nodiscard]] auto types::type::is_signed() const noexcept -> bool {
     return true;
 }